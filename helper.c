@@ -2,87 +2,225 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <math.h>
 #include "miniproj.h"
 
-// Global variables
-
-static struct Order *front = NULL; // Front pointer of the priority queue
-
 // Runtime-configurable settings (defaults)
 int LOW_STOCK_THRESHOLD = 5;
 int MAX_HISTORY = 100;
+int REORDER_LEAD_DAYS = 7;
 
-// Dynamically allocated sales history (size = MAX_HISTORY)
-struct SalesRecord *salesHistory = NULL; // allocated by initConfig
-int salesCount = 0; // Counter for sales records
-
-// Initialize runtime configuration (call early from main)
-void initConfig(int lowStockThreshold, int maxHistory) {
+// Initialize runtime configuration (call early from main). Each warehouse
+// allocates its own sales history on its first sale.
+void initConfig(int lowStockThreshold, int maxHistory, int leadDays) {
     if (lowStockThreshold > 0) LOW_STOCK_THRESHOLD = lowStockThreshold;
-    if (maxHistory > 0) {
-        MAX_HISTORY = maxHistory;
-        if (salesHistory != NULL) {
-            free(salesHistory);
-            salesHistory = NULL;
-            salesCount = 0;
-        }
-        salesHistory = (struct SalesRecord*)malloc(sizeof(struct SalesRecord) * MAX_HISTORY);
-        if (salesHistory == NULL) {
-            fprintf(stderr, "Failed to allocate sales history with size %d\n", MAX_HISTORY);
-            MAX_HISTORY = 0;
-        }
-    }
+    if (leadDays > 0) REORDER_LEAD_DAYS = leadDays;
+    if (maxHistory > 0) MAX_HISTORY = maxHistory;
 }
 
 // ---------------------- BST IMPLEMENTATION ----------------------
 
 // Inserts a new product node into the Binary Search Tree
 struct Product* insertBST(struct Product* root, int id, char name[], int stock, float price,char supplier[]) {
-    if (root == NULL) {
-        struct Product* newNode = (struct Product*)malloc(sizeof(struct Product));
-        newNode->id = id;
-        strcpy(newNode->name, name);
-        newNode->stock = stock;
-        newNode->price = price;
-        strcpy(newNode->supplier, supplier);
-        newNode->lowStockFlag = (stock < LOW_STOCK_THRESHOLD) ? 1 : 0;
-        newNode->left = newNode->right = NULL;
-        return newNode;
+    traceInsertProduct(id, name, stock, price, supplier);
+
+    // Walk down iteratively so a degenerate tree cannot overflow the stack
+    struct Product **link = &root;
+    while (*link != NULL) {
+        if (id == (*link)->id) {
+            printf("Product ID %d already exists!\n", id);
+            return root;
+        }
+        link = (id < (*link)->id) ? &(*link)->left : &(*link)->right;
     }
 
-    if (id == root->id) {
-        printf("Product ID %d already exists!\n", id);
-        return root;
+    struct Product* newNode = (struct Product*)malloc(sizeof(struct Product));
+    newNode->id = id;
+    newNode->name = internString(name);
+    newNode->stock = stock;
+    newNode->price = price;
+    newNode->supplier = internString(supplier);
+    newNode->velocity = 0.0f;
+    newNode->velocityVar = 0.0f;
+    newNode->unitsToday = 0;
+    newNode->lastSaleDay = -1;
+    newNode->lowStockFlag = isLowStock(newNode, todaySalesDay());
+    newNode->totalUnitsSold = 0;
+    newNode->totalRevenue = 0.0;
+    newNode->left = newNode->right = NULL;
+    rankTrackProduct(newNode);
+    *link = newNode;
+    return root;
+}
+
+// Searches for a product in the BST
+struct Product* searchBST(struct Product* root, int id) {
+    while (root != NULL && root->id != id)
+        root = (id < root->id) ? root->left : root->right;
+    return root;
+}
+
+// ---------------------- PRODUCT CURSOR ----------------------
+//
+// In-order iteration without recursion. The cursor keeps the root-to-current
+// path in a growable heap array, so a degenerate tree cannot overflow the call
+// stack, and it can step both ways. To resume after the tree has changed,
+// seek again from the last ID seen.
+
+void cursorInit(struct ProductCursor *c) {
+    c->path = NULL;
+    c->depth = 0;
+    c->cap = 0;
+}
+
+void cursorFree(struct ProductCursor *c) {
+    free(c->path);
+    cursorInit(c);
+}
+
+static int cursorPush(struct ProductCursor *c, struct Product *p) {
+    if (c->depth == c->cap) {
+        int newCap = c->cap ? c->cap * 2 : 32;
+        struct Product **path = (struct Product**)realloc(c->path, sizeof(struct Product*) * newCap);
+        if (path == NULL) {
+            fprintf(stderr, "Product cursor: out of memory\n");
+            c->depth = 0;
+            return 0;
+        }
+        c->path = path;
+        c->cap = newCap;
     }
+    c->path[c->depth++] = p;
+    return 1;
+}
 
-    if (id < root->id)
-        root->left = insertBST(root->left, id, name, stock, price,supplier);
-    else
-        root->right = insertBST(root->right, id, name, stock, price,supplier);
+// Product the cursor is on, or NULL when it has run off either end
+struct Product* cursorCurrent(struct ProductCursor *c) {
+    return c->depth > 0 ? c->path[c->depth - 1] : NULL;
+}
 
-    return root;
+// Positions the cursor on the first product with ID >= id
+struct Product* cursorSeek(struct ProductCursor *c, struct Product *root, int id) {
+    int keep = 0; // path length up to the smallest node seen with ID > id
+    c->depth = 0;
+    while (root != NULL) {
+        if (!cursorPush(c, root))
+            return NULL;
+        if (id == root->id)
+            return root;
+        if (id < root->id) {
+            keep = c->depth;
+            root = root->left;
+        } else {
+            root = root->right;
+        }
+    }
+    c->depth = keep;
+    return cursorCurrent(c);
 }
 
-// Searches for a product in the BST using recursive algorithm
-struct Product* searchBST(struct Product* root, int id) {
-    if (root == NULL || root->id == id)
-        return root;
-    if (id < root->id)
-        return searchBST(root->left, id);
-    else
-        return searchBST(root->right, id);
+// Positions the cursor on the product with the lowest ID
+struct Product* cursorFirst(struct ProductCursor *c, struct Product *root) {
+    c->depth = 0;
+    for (; root != NULL; root = root->left)
+        if (!cursorPush(c, root))
+            return NULL;
+    return cursorCurrent(c);
 }
 
-// Performs in-order traversal to display products in sorted order
-void inorderBST(struct Product* root) {
-    if (root == NULL)
-        return; // just return, no print here
+// Positions the cursor on the product with the highest ID
+struct Product* cursorLast(struct ProductCursor *c, struct Product *root) {
+    c->depth = 0;
+    for (; root != NULL; root = root->right)
+        if (!cursorPush(c, root))
+            return NULL;
+    return cursorCurrent(c);
+}
+
+// Advances to the next product in ID order
+struct Product* cursorNext(struct ProductCursor *c) {
+    struct Product *cur = cursorCurrent(c);
+    if (cur == NULL)
+        return NULL;
+
+    if (cur->right != NULL) {
+        for (cur = cur->right; cur != NULL; cur = cur->left)
+            if (!cursorPush(c, cur))
+                return NULL;
+    } else {
+        // Climb until we leave a left subtree
+        struct Product *child;
+        do {
+            child = c->path[--c->depth];
+        } while (c->depth > 0 && c->path[c->depth - 1]->right == child);
+    }
+    return cursorCurrent(c);
+}
+
+// Steps back to the previous product in ID order
+struct Product* cursorPrev(struct ProductCursor *c) {
+    struct Product *cur = cursorCurrent(c);
+    if (cur == NULL)
+        return NULL;
+
+    if (cur->left != NULL) {
+        for (cur = cur->left; cur != NULL; cur = cur->right)
+            if (!cursorPush(c, cur))
+                return NULL;
+    } else {
+        // Climb until we leave a right subtree
+        struct Product *child;
+        do {
+            child = c->path[--c->depth];
+        } while (c->depth > 0 && c->path[c->depth - 1]->left == child);
+    }
+    return cursorCurrent(c);
+}
 
-    inorderBST(root->left);
+// Fills out[] with up to pageSize products adjacent to anchorId, in ascending
+// ID order: those after it, or with backward set, those before it. Returns
+// how many were written. Costs O(height + pageSize), however large the catalog.
+int productPage(struct Product *root, int anchorId, int pageSize, int backward, struct Product **out) {
+    struct ProductCursor c;
+    struct Product *p;
+    int n = 0;
+
+    cursorInit(&c);
+    p = cursorSeek(&c, root, anchorId);
+    if (!backward) {
+        if (p != NULL && p->id == anchorId)
+            p = cursorNext(&c);
+        for (; p != NULL && n < pageSize; p = cursorNext(&c))
+            out[n++] = p;
+    } else {
+        p = (p == NULL) ? cursorLast(&c, root) : cursorPrev(&c);
+        for (; p != NULL && n < pageSize; p = cursorPrev(&c))
+            out[n++] = p;
+        // Collected in descending order; flip to ascending
+        for (int i = 0; i < n / 2; i++) {
+            struct Product *t = out[i];
+            out[i] = out[n - 1 - i];
+            out[n - 1 - i] = t;
+        }
+    }
+    cursorFree(&c);
+    return n;
+}
+
+// Prints one product as a line of the inventory listing
+void printProductLine(struct Product *p) {
     printf("ID: %4d | Name: %-20s | Stock: %4d | Price: $%7.2f | %s | Supplier Name: %-20s \n",
-           root->id, root->name, root->stock, root->price,
-           root->lowStockFlag ? "LOW STOCK" : "        ", root->supplier);
-    inorderBST(root->right);
+           p->id, stringOf(p->name), p->stock, p->price,
+           p->lowStockFlag ? "LOW STOCK" : "        ", stringOf(p->supplier));
+}
+
+// Performs in-order traversal to display products in sorted order
+void inorderBST(struct Product* root) {
+    struct ProductCursor c;
+    cursorInit(&c);
+    for (struct Product *p = cursorFirst(&c, root); p != NULL; p = cursorNext(&c))
+        printProductLine(p);
+    cursorFree(&c);
 }
 // Finds the product with the minimum ID in the BST
 struct Product* findMin(struct Product* root) {
@@ -91,70 +229,265 @@ struct Product* findMin(struct Product* root) {
     return root;
 }
 
-// Deletes a product node from the BST using recursive algorithm
+// Deletes a product node from the BST
 struct Product* deleteProductBST(struct Product* root, int id) {
-    if (root == NULL) return root;
-
-    if (id < root->id)
-        root->left = deleteProductBST(root->left, id);
-    else if (id > root->id)
-        root->right = deleteProductBST(root->right, id);
-    else {
-        if (root->left == NULL) {
-            struct Product* temp = root->right;
-            free(root);
-            return temp;
-        } else if (root->right == NULL) {
-            struct Product* temp = root->left;
-            free(root);
-            return temp;
-        }
-
-        struct Product* temp = findMin(root->right);
-        root->id = temp->id;
-        strcpy(root->name, temp->name);
-        root->stock = temp->stock;
-        root->price = temp->price;
-        root->lowStockFlag = temp->lowStockFlag;
-        root->right = deleteProductBST(root->right, temp->id);
+    traceDeleteProduct(id);
+    struct Product **link = &root;
+    while (*link != NULL && (*link)->id != id)
+        link = (id < (*link)->id) ? &(*link)->left : &(*link)->right;
+    if (*link == NULL) return root;
+
+    struct Product *node = *link;
+    if (node->left == NULL || node->right == NULL) {
+        *link = (node->left != NULL) ? node->left : node->right;
+        rankUntrackProduct(node);
+        free(node);
+        return root;
     }
+
+    // Two children: this node takes over the successor's data, including its
+    // ranking slots, and the successor node is unlinked instead
+    struct Product **succLink = &node->right;
+    while ((*succLink)->left != NULL)
+        succLink = &(*succLink)->left;
+    struct Product *temp = *succLink;
+
+    rankUntrackProduct(node);
+    node->id = temp->id;
+    node->name = temp->name;
+    node->supplier = temp->supplier;
+    node->stock = temp->stock;
+    node->price = temp->price;
+    node->lowStockFlag = temp->lowStockFlag;
+    node->velocity = temp->velocity;
+    node->velocityVar = temp->velocityVar;
+    node->unitsToday = temp->unitsToday;
+    node->lastSaleDay = temp->lastSaleDay;
+    node->totalUnitsSold = temp->totalUnitsSold;
+    node->totalRevenue = temp->totalRevenue;
+    rankMoveProduct(temp, node);
+
+    *succLink = temp->right;
+    free(temp);
     return root;
 }
 
 // Counts the total number of products in the BST
 int countProducts(struct Product* root) {
-    if (root == NULL) return 0;
-    return 1 + countProducts(root->left) + countProducts(root->right);
+    struct ProductCursor c;
+    int count = 0;
+    cursorInit(&c);
+    for (struct Product *p = cursorFirst(&c, root); p != NULL; p = cursorNext(&c))
+        count++;
+    cursorFree(&c);
+    return count;
+}
+
+// Counts products at or below their reorder point
+int countLowStockProducts(struct Product* root) {
+    struct ProductCursor c;
+    int today = todaySalesDay();
+    int count = 0;
+    cursorInit(&c);
+    for (struct Product *p = cursorFirst(&c, root); p != NULL; p = cursorNext(&c))
+        if (isLowStock(p, today)) count++;
+    cursorFree(&c);
+    return count;
 }
 
-// Displays only products that are below low stock threshold
+// Displays only products that are at or below their reorder point
 void displayLowStock(struct Product* root) {
-    if (root == NULL) return;
-    
-    displayLowStock(root->left);
-    if (root->lowStockFlag) {
-        printf("ID: %4d | Name: %-20s | Stock: %4d | Price: $%7.2f\n",
-               root->id, root->name, root->stock, root->price);
+    struct ProductCursor c;
+    int today = todaySalesDay();
+    cursorInit(&c);
+    for (struct Product *p = cursorFirst(&c, root); p != NULL; p = cursorNext(&c)) {
+        if (isLowStock(p, today)) {
+            printf("ID: %4d | Name: %-20s | Stock: %4d | Price: $%7.2f\n",
+                   p->id, stringOf(p->name), p->stock, p->price);
+        }
     }
-    displayLowStock(root->right);
+    cursorFree(&c);
+}
+
+// ---------------------- SALES VELOCITY ----------------------
+
+// Days of inactivity after which the velocity is treated as zero
+#define VELOCITY_MAX_IDLE_DAYS 64
+
+// Computes velocity and variance as of the start of `day`: the open day bucket
+// is folded in and every following day without sales decays the average.
+// Bounded by VELOCITY_MAX_IDLE_DAYS, so this is O(1) per call.
+static void rollVelocity(const struct Product *p, int day, float *v, float *var) {
+    *v = p->velocity;
+    *var = p->velocityVar;
+    if (p->lastSaleDay < 0 || day <= p->lastSaleDay)
+        return;
+
+    if (*v == 0.0f && *var == 0.0f) {
+        // No history yet (or fully decayed): seed with the closed day's demand
+        *v = (float)p->unitsToday;
+    } else {
+        float d = p->unitsToday - *v;
+        *v += VELOCITY_ALPHA * d;
+        *var = (1.0f - VELOCITY_ALPHA) * (*var + VELOCITY_ALPHA * d * d);
+    }
+
+    int idle = day - p->lastSaleDay - 1;
+    if (idle > VELOCITY_MAX_IDLE_DAYS) {
+        *v = 0.0f;
+        *var = 0.0f;
+        return;
+    }
+    for (int i = 0; i < idle; i++) {
+        *var = (1.0f - VELOCITY_ALPHA) * (*var + VELOCITY_ALPHA * *v * *v);
+        *v *= 1.0f - VELOCITY_ALPHA;
+    }
+}
+
+// Records units sold for a product on the given day
+void recordSaleVelocity(struct Product *p, int quantity, int day) {
+    if (p->lastSaleDay < 0) {
+        p->lastSaleDay = day;
+        p->unitsToday = 0;
+    } else if (day > p->lastSaleDay) {
+        rollVelocity(p, day, &p->velocity, &p->velocityVar);
+        p->lastSaleDay = day;
+        p->unitsToday = 0;
+    }
+    p->unitsToday += quantity;
+}
+
+// Estimated units sold per day, counting today as a completed day
+float currentVelocity(const struct Product *p, int today) {
+    float v, var;
+    rollVelocity(p, today + 1, &v, &var);
+    return v;
+}
+
+// Stock level at which the product should be reordered: expected demand over
+// the supplier lead time plus safety stock. Falls back to LOW_STOCK_THRESHOLD
+// for products with no current demand estimate: never sold, or idle long
+// enough for the velocity to decay to zero.
+int reorderPoint(const struct Product *p, int today) {
+    if (p->lastSaleDay < 0)
+        return LOW_STOCK_THRESHOLD;
+
+    float v, var;
+    rollVelocity(p, today + 1, &v, &var);
+    if (v <= 0.0f)
+        return LOW_STOCK_THRESHOLD;
+    float demand = v * REORDER_LEAD_DAYS;
+    float safety = REORDER_SAFETY_Z * sqrtf(var * REORDER_LEAD_DAYS);
+    return (int)ceilf(demand + safety);
+}
+
+// Returns 1 if the product is at or below its reorder point. Every low stock
+// flag, alert and report goes through here, so fast sellers are flagged
+// before they run out and unsold products use LOW_STOCK_THRESHOLD.
+int isLowStock(const struct Product *p, int today) {
+    return p->stock <= reorderPoint(p, today);
+}
+
+// Projected days until the product runs out, or -1 if it is not selling
+float daysOfStock(const struct Product *p, int today) {
+    float v = currentVelocity(p, today);
+    if (v <= 0.0f)
+        return -1.0f;
+    return p->stock / v;
+}
+
+struct Replenishment {
+    struct Product *product;
+    float velocity;
+    int reorderAt;
+    float daysLeft;
+};
+
+// Collects products at or below their reorder point
+static void collectReplenishments(struct Product *root, int today, struct Replenishment **list,
+                                  int *count, int *cap) {
+    struct ProductCursor c;
+    cursorInit(&c);
+    for (struct Product *p = cursorFirst(&c, root); p != NULL; p = cursorNext(&c)) {
+        int rop = reorderPoint(p, today);
+        if (p->stock > rop)
+            continue;
+        if (*count == *cap) {
+            int newCap = *cap ? *cap * 2 : 64;
+            struct Replenishment *grown = (struct Replenishment*)realloc(*list, sizeof(struct Replenishment) * newCap);
+            if (grown == NULL) break;
+            *list = grown;
+            *cap = newCap;
+        }
+        (*list)[*count].product = p;
+        (*list)[*count].velocity = currentVelocity(p, today);
+        (*list)[*count].reorderAt = rop;
+        (*list)[*count].daysLeft = daysOfStock(p, today);
+        (*count)++;
+    }
+    cursorFree(&c);
+}
+
+// Most urgent first: fewest days of stock, non-selling products last
+static int compareReplenishment(const void *a, const void *b) {
+    float da = ((const struct Replenishment*)a)->daysLeft;
+    float db = ((const struct Replenishment*)b)->daysLeft;
+    if (da < 0) da = 1e30f;
+    if (db < 0) db = 1e30f;
+    return (da > db) - (da < db);
+}
+
+// Lists products that have reached their reorder point with a suggested order
+// quantity covering one more lead time of demand. Uses the per-product
+// velocity counters only; the sales history is not rescanned.
+void displayReplenishmentSuggestions(struct Product *root) {
+    int today = todaySalesDay();
+    struct Replenishment *list = NULL;
+    int count = 0, cap = 0;
+
+    collectReplenishments(root, today, &list, &count, &cap);
+    if (count == 0) {
+        printf("No products need replenishment.\n");
+        free(list);
+        return;
+    }
+
+    qsort(list, count, sizeof(struct Replenishment), compareReplenishment);
+    printf("Lead time: %d days\n", REORDER_LEAD_DAYS);
+    for (int i = 0; i < count; i++) {
+        struct Product *p = list[i].product;
+        int target = list[i].reorderAt + (int)ceilf(list[i].velocity * REORDER_LEAD_DAYS);
+        int suggest = target - p->stock;
+        if (suggest < 1) suggest = 1;
+        if (list[i].daysLeft < 0)
+            printf("ID: %4d | Name: %-20s | Stock: %4d | Velocity: %6.2f/day | Reorder At: %4d | Days Left:    n/a | Suggest: %4d\n",
+                   p->id, stringOf(p->name), p->stock, list[i].velocity, list[i].reorderAt, suggest);
+        else
+            printf("ID: %4d | Name: %-20s | Stock: %4d | Velocity: %6.2f/day | Reorder At: %4d | Days Left: %6.1f | Suggest: %4d\n",
+                   p->id, stringOf(p->name), p->stock, list[i].velocity, list[i].reorderAt, list[i].daysLeft, suggest);
+    }
+    printf("Products to replenish: %d\n", count);
+    free(list);
 }
 
 // ---------------------- PRIORITY QUEUE USING LINKED LIST ----------------------
 
 // Inserts a new order into the priority queue maintaining priority order
 void insertPQ(int id, int quantity, int priority, char customerName[]) {
+    struct Warehouse *wh = activeWarehouse;
+    traceInsertOrder(id, quantity, priority, customerName);
     struct Order *newOrder = (struct Order*)malloc(sizeof(struct Order));
     newOrder->productId = id;
     newOrder->quantity = quantity;
     newOrder->priority = priority;
-    strcpy(newOrder->customerName, customerName);
+    newOrder->customerName = internString(customerName);
     newOrder->next = NULL;
 
-    if (front == NULL || priority > front->priority) {
-        newOrder->next = front;
-        front = newOrder;
+    if (wh->front == NULL || priority > wh->front->priority) {
+        newOrder->next = wh->front;
+        wh->front = newOrder;
     } else {
-        struct Order *temp = front;
+        struct Order *temp = wh->front;
         while (temp->next != NULL && temp->next->priority >= priority)
             temp = temp->next;
         newOrder->next = temp->next;
@@ -168,27 +501,30 @@ void insertPQ(int id, int quantity, int priority, char customerName[]) {
 
 // Removes and returns the order with highest priority (front of queue)
 struct Order* deleteMax() {
-    if (front == NULL)
+    struct Warehouse *wh = activeWarehouse;
+    traceDeleteMax();
+    if (wh->front == NULL)
         return NULL;
 
-    struct Order *temp = front;
-    front = front->next;
+    struct Order *temp = wh->front;
+    wh->front = wh->front->next;
     return temp;
 }
 
 // Displays all pending orders in priority order
 void displayOrders() {
-    if (front == NULL) {
+    struct Warehouse *wh = activeWarehouse;
+    if (wh->front == NULL) {
         printf("No pending orders.\n");
         return;
     }
 
     printf("\n=== PENDING ORDERS (by priority) ===\n");
-    struct Order *temp = front;
+    struct Order *temp = wh->front;
     int count = 1;
     while (temp != NULL) {
         printf("%d. Customer: %-15s | Product ID: %4d | Quantity: %3d | Priority: %2d\n",
-               count++, temp->customerName, temp->productId, temp->quantity, temp->priority);
+               count++, stringOf(temp->customerName), temp->productId, temp->quantity, temp->priority);
         temp = temp->next;
     }
     printf("Total Orders: %d\n", count-1);
@@ -196,8 +532,9 @@ void displayOrders() {
 
 // Counts the number of orders currently in the priority queue
 int countPendingOrders() {
+    struct Warehouse *wh = activeWarehouse;
     int count = 0;
-    struct Order *temp = front;
+    struct Order *temp = wh->front;
     while (temp != NULL) {
         count++;
         temp = temp->next;
@@ -205,9 +542,31 @@ int countPendingOrders() {
     return count;
 }
 
-// Clears all orders from the priority queue
+// Total quantity of a product waiting in the order queue
+int pendingQuantity(int productId) {
+    struct Warehouse *wh = activeWarehouse;
+    int total = 0;
+    for (struct Order *temp = wh->front; temp != NULL; temp = temp->next)
+        if (temp->productId == productId)
+            total += temp->quantity;
+    return total;
+}
+
+// Frees every pending order of the active warehouse
+void clearOrders() {
+    struct Warehouse *wh = activeWarehouse;
+    traceClearOrders();
+    while (wh->front != NULL) {
+        struct Order *temp = wh->front;
+        wh->front = wh->front->next;
+        free(temp);
+    }
+}
+
+// Clears all orders from the priority queue after confirmation
 void clearAllOrders() {
-    if (front == NULL) {
+    struct Warehouse *wh = activeWarehouse;
+    if (wh->front == NULL) {
         printf("No orders to clear.\n");
         return;
     }
@@ -217,12 +576,7 @@ void clearAllOrders() {
     scanf("%d", &confirm);
     
     if (confirm) {
-        struct Order *temp;
-        while (front != NULL) {
-            temp = front;
-            front = front->next;
-            free(temp);
-        }
+        clearOrders();
         printf("All orders cleared successfully!\n");
     } else {
         printf("Operation cancelled.\n");
@@ -231,58 +585,88 @@ void clearAllOrders() {
 
 // ---------------------- SALES HISTORY FUNCTIONS ----------------------
 
+// Moves every in-memory sales record into the compressed sales archive
+static void sealSalesHistory() {
+    struct Warehouse *wh = activeWarehouse;
+    if (wh->salesCount == 0) {
+        printf("No sales records to archive.\n");
+        return;
+    }
+
+    int archived = archiveSalesRecords(wh->salesHistory, wh->salesCount);
+    if (archived < wh->salesCount)
+        memmove(wh->salesHistory, wh->salesHistory + archived, sizeof(struct SalesRecord) * (wh->salesCount - archived));
+    wh->salesCount -= archived;
+    printf("Archived %d sales records (%ld total in archive).\n", archived, archivedSalesCount());
+}
+
 // Adds a completed sale to the sales history array
-void addSalesRecord(int id, char name[], int quantity, float amount, char date[]) {
-    if (salesHistory == NULL) {
+void addSalesRecord(int id, StrId name, int quantity, float amount, char date[]) {
+    struct Warehouse *wh = activeWarehouse;
+    if (wh->salesHistory == NULL) {
         // attempt lazy allocation with current MAX_HISTORY
         if (MAX_HISTORY > 0) {
-            salesHistory = (struct SalesRecord*)malloc(sizeof(struct SalesRecord) * MAX_HISTORY);
-            if (salesHistory == NULL) {
+            wh->salesHistory = (struct SalesRecord*)malloc(sizeof(struct SalesRecord) * MAX_HISTORY);
+            if (wh->salesHistory == NULL) {
                 printf("Unable to record sale: out of memory.\n");
                 return;
             }
-            salesCount = 0;
+            wh->salesCount = 0;
         } else {
             printf("Sales history disabled (MAX_HISTORY=0).\n");
             return;
         }
     }
 
-    if (salesCount < MAX_HISTORY) {
-        salesHistory[salesCount].productId = id;
-        strcpy(salesHistory[salesCount].productName, name);
-        salesHistory[salesCount].quantitySold = quantity;
-        salesHistory[salesCount].totalAmount = amount;
-        strcpy(salesHistory[salesCount].date, date);
-        salesCount++;
+    if (wh->salesCount < MAX_HISTORY) {
+        wh->salesHistory[wh->salesCount].productId = id;
+        wh->salesHistory[wh->salesCount].productName = name;
+        wh->salesHistory[wh->salesCount].quantitySold = quantity;
+        wh->salesHistory[wh->salesCount].totalAmount = amount;
+        strcpy(wh->salesHistory[wh->salesCount].date, date);
+        wh->salesCount++;
     } else {
-        printf("Sales history full. Cannot add more records.\n");
+        // Seal the full history into the archive and start a fresh window
+        sealSalesHistory();
+        if (wh->salesCount < MAX_HISTORY)
+            addSalesRecord(id, name, quantity, amount, date);
+        else
+            printf("Sales history full. Cannot add more records.\n");
     }
 }
 
+// Archives the sales history on request. Only this entry point is traced:
+// archiving because the history filled up replays with the sale behind it.
+void archiveSalesHistory() {
+    traceArchiveSales();
+    sealSalesHistory();
+}
+
 // Displays comprehensive sales report with totals
 void displaySalesReport() {
-    if (salesCount == 0) {
+    struct Warehouse *wh = activeWarehouse;
+    if (wh->salesCount == 0) {
         printf("No sales records available.\n");
         return;
     }
     
     printf("\n=== SALES REPORT ===\n");
     float totalRevenue = 0;
-    for (int i = 0; i < salesCount; i++) {
+    for (int i = 0; i < wh->salesCount; i++) {
         printf("Date: %s | Product: %-20s | Qty: %3d | Amount: $%7.2f\n",
-               salesHistory[i].date, salesHistory[i].productName,
-               salesHistory[i].quantitySold, salesHistory[i].totalAmount);
-        totalRevenue += salesHistory[i].totalAmount;
+               wh->salesHistory[i].date, stringOf(wh->salesHistory[i].productName),
+               wh->salesHistory[i].quantitySold, wh->salesHistory[i].totalAmount);
+        totalRevenue += wh->salesHistory[i].totalAmount;
     }
-    printf("Total Sales: %d transactions | Total Revenue: $%.2f\n", salesCount, totalRevenue);
+    printf("Total Sales: %d transactions | Total Revenue: $%.2f\n", wh->salesCount, totalRevenue);
 }
 
-// Calculates total revenue from all sales records
+// Calculates total revenue from all sales records, including archived ones
 float calculateTotalRevenue() {
-    float total = 0;
-    for (int i = 0; i < salesCount; i++) {
-        total += salesHistory[i].totalAmount;
+    struct Warehouse *wh = activeWarehouse;
+    float total = archivedRevenue();
+    for (int i = 0; i < wh->salesCount; i++) {
+        total += wh->salesHistory[i].totalAmount;
     }
     return total;
 }
\ No newline at end of file
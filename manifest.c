@@ -0,0 +1,301 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <math.h>
+#include <pthread.h>
+#include "miniproj.h"
+
+// ---------------------- BULK RESTOCK FROM MANIFEST ----------------------
+//
+// A supplier manifest has one delivery per line:
+//   <product id> <quantity> [<new price>]
+// separated by commas, semicolons or whitespace. Blank lines and lines
+// starting with '#' are ignored. The file is split at line boundaries into
+// chunks that are parsed and sorted on separate threads, the sorted chunks
+// are merged so each product appears once, and the result is applied in a
+// single in-order pass over the active warehouse's product index.
+
+// Minimum bytes per parser thread, so small files are not over-split
+#define MANIFEST_MIN_CHUNK (64 * 1024)
+
+// Reasons a merged manifest entry was not applied
+#define MANIFEST_UNKNOWN_ID 1
+#define MANIFEST_OVERFLOW 2
+
+struct ManifestEntry {
+    int id;
+    long long quantity;         // Units delivered (summed after merging)
+    float price;                // New price, valid if hasPrice
+    int hasPrice;
+    long long seq;              // File offset of the line; the last price wins
+    int unapplied;              // MANIFEST_UNKNOWN_ID or MANIFEST_OVERFLOW if skipped
+};
+
+struct ManifestChunk {
+    const char *begin, *end;    // Lines to parse (end is exclusive)
+    long long offset;           // File offset of begin
+    struct ManifestEntry *entries;
+    int count, cap;
+    int lines, malformed;
+    int outOfMemory;
+};
+
+static int isSeparator(char c) {
+    return c == ' ' || c == '\t' || c == ',' || c == ';' || c == '\r';
+}
+
+static int compareEntries(const void *a, const void *b) {
+    const struct ManifestEntry *x = (const struct ManifestEntry*)a;
+    const struct ManifestEntry *y = (const struct ManifestEntry*)b;
+    if (x->id != y->id) return (x->id > y->id) - (x->id < y->id);
+    return (x->seq > y->seq) - (x->seq < y->seq);
+}
+
+// Parses one chunk of lines and sorts the entries by product ID
+static void* parseChunk(void *arg) {
+    struct ManifestChunk *ch = (struct ManifestChunk*)arg;
+    const char *p = ch->begin;
+
+    while (p < ch->end) {
+        const char *line = p;
+        const char *eol = memchr(p, '\n', (size_t)(ch->end - p));
+        if (eol == NULL) eol = ch->end;
+        p = eol + 1;
+
+        const char *s = line;
+        while (s < eol && isSeparator(*s)) s++;
+        if (s == eol || *s == '#')
+            continue;
+        ch->lines++;
+
+        // strtol/strtof stop at the newline, and the buffer is NUL-terminated.
+        // Out of range IDs and quantities and non-finite prices are malformed.
+        char *end;
+        errno = 0;
+        long id = strtol(s, &end, 10);
+        int ok = end != s && end <= eol && errno != ERANGE && id >= 0 && id <= INT_MAX;
+        s = end;
+        while (ok && s < eol && isSeparator(*s)) s++;
+
+        long long quantity = ok ? strtoll(s, &end, 10) : 0;
+        ok = ok && end != s && end <= eol && errno != ERANGE && quantity >= 0 && quantity <= INT_MAX;
+        s = end;
+        while (ok && s < eol && isSeparator(*s)) s++;
+
+        float price = 0.0f;
+        int hasPrice = 0;
+        if (ok && s < eol) {
+            price = strtof(s, &end);
+            ok = end != s && end <= eol && isfinite(price) && price >= 0.0f;
+            hasPrice = 1;
+            s = end;
+            while (ok && s < eol && isSeparator(*s)) s++;
+            ok = ok && s == eol;
+        }
+        if (!ok) {
+            ch->malformed++;
+            continue;
+        }
+
+        if (ch->count == ch->cap) {
+            int newCap = ch->cap ? ch->cap * 2 : 1024;
+            struct ManifestEntry *grown = (struct ManifestEntry*)realloc(ch->entries, sizeof(struct ManifestEntry) * newCap);
+            if (grown == NULL) {
+                ch->outOfMemory = 1;
+                return NULL;
+            }
+            ch->entries = grown;
+            ch->cap = newCap;
+        }
+        struct ManifestEntry *e = &ch->entries[ch->count++];
+        e->id = (int)id;
+        e->quantity = quantity;
+        e->price = price;
+        e->hasPrice = hasPrice;
+        e->seq = ch->offset + (line - ch->begin);
+        e->unapplied = 0;
+    }
+
+    qsort(ch->entries, ch->count, sizeof(struct ManifestEntry), compareEntries);
+    return NULL;
+}
+
+// Merges the sorted chunks into one list with a single entry per product:
+// quantities are summed (saturating at LLONG_MAX) and the price from the
+// latest line is kept
+static struct ManifestEntry* mergeChunks(struct ManifestChunk *chunks, int numChunks, int *outCount) {
+    int total = 0, pos[MANIFEST_MAX_THREADS] = {0};
+    for (int i = 0; i < numChunks; i++)
+        total += chunks[i].count;
+
+    struct ManifestEntry *merged = (struct ManifestEntry*)malloc(sizeof(struct ManifestEntry) * (total ? total : 1));
+    if (merged == NULL)
+        return NULL;
+
+    int n = 0;
+    while (1) {
+        // Pick the smallest head among the chunks (few chunks, so a linear scan)
+        int best = -1;
+        for (int i = 0; i < numChunks; i++) {
+            if (pos[i] == chunks[i].count) continue;
+            if (best < 0 || compareEntries(&chunks[i].entries[pos[i]], &chunks[best].entries[pos[best]]) < 0)
+                best = i;
+        }
+        if (best < 0) break;
+
+        const struct ManifestEntry *e = &chunks[best].entries[pos[best]++];
+        if (n > 0 && merged[n - 1].id == e->id) {
+            if (merged[n - 1].quantity > LLONG_MAX - e->quantity)
+                merged[n - 1].quantity = LLONG_MAX;
+            else
+                merged[n - 1].quantity += e->quantity;
+            if (e->hasPrice) {
+                merged[n - 1].price = e->price;
+                merged[n - 1].hasPrice = 1;
+            }
+        } else {
+            merged[n++] = *e;
+        }
+    }
+    *outCount = n;
+    return merged;
+}
+
+// Reads a manifest, restocks the active warehouse and writes a summary to
+// summaryPath. Returns 1 on success.
+int bulkRestockFromManifest(const char *path, const char *summaryPath) {
+    long long start = nowNanos();
+
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        printf("Unable to open manifest %s.\n", path);
+        return 0;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *buf = (size >= 0) ? (char*)malloc((size_t)size + 1) : NULL;
+    if (buf == NULL || fread(buf, 1, (size_t)size, f) != (size_t)size) {
+        printf("Unable to read manifest %s.\n", path);
+        free(buf);
+        fclose(f);
+        return 0;
+    }
+    fclose(f);
+    buf[size] = '\0';
+
+    // Split at line boundaries, one chunk per thread
+    int numChunks = (int)(size / MANIFEST_MIN_CHUNK) + 1;
+    if (numChunks > MANIFEST_MAX_THREADS) numChunks = MANIFEST_MAX_THREADS;
+    struct ManifestChunk chunks[MANIFEST_MAX_THREADS];
+    pthread_t threads[MANIFEST_MAX_THREADS];
+    int started[MANIFEST_MAX_THREADS];
+    const char *cut = buf;
+    for (int i = 0; i < numChunks; i++) {
+        memset(&chunks[i], 0, sizeof(chunks[i]));
+        chunks[i].begin = cut;
+        chunks[i].offset = cut - buf;
+        if (i == numChunks - 1) {
+            cut = buf + size;
+        } else {
+            cut = buf + (long)size * (i + 1) / numChunks;
+            if (cut < chunks[i].begin) cut = chunks[i].begin;
+            const char *nl = memchr(cut, '\n', (size_t)(buf + size - cut));
+            cut = nl ? nl + 1 : buf + size;
+        }
+        chunks[i].end = cut;
+    }
+
+    for (int i = 0; i < numChunks; i++) {
+        started[i] = pthread_create(&threads[i], NULL, parseChunk, &chunks[i]) == 0;
+        if (!started[i])
+            parseChunk(&chunks[i]); // Parse inline if a thread cannot be started
+    }
+    int outOfMemory = 0, lines = 0, malformed = 0;
+    for (int i = 0; i < numChunks; i++) {
+        if (started[i])
+            pthread_join(threads[i], NULL);
+        outOfMemory |= chunks[i].outOfMemory;
+        lines += chunks[i].lines;
+        malformed += chunks[i].malformed;
+    }
+
+    int count = 0;
+    struct ManifestEntry *merged = outOfMemory ? NULL : mergeChunks(chunks, numChunks, &count);
+    for (int i = 0; i < numChunks; i++)
+        free(chunks[i].entries);
+    free(buf);
+    if (merged == NULL) {
+        printf("Not enough memory to process manifest %s.\n", path);
+        return 0;
+    }
+    double parseSecs = (nowNanos() - start) / 1e9;
+
+    // Single in-order pass: walk the index and the sorted manifest together
+    struct ProductCursor c;
+    long long unitsAdded = 0;
+    int applied = 0, pricesUpdated = 0, unknown = 0, rejected = 0;
+    int today = todaySalesDay();
+    cursorInit(&c);
+    struct Product *p = (count > 0) ? cursorSeek(&c, activeWarehouse->root, merged[0].id) : NULL;
+    for (int i = 0; i < count; i++) {
+        while (p != NULL && p->id < merged[i].id)
+            p = cursorNext(&c);
+        if (p == NULL || p->id != merged[i].id) {
+            unknown++;
+            merged[i].unapplied = MANIFEST_UNKNOWN_ID;
+            continue;
+        }
+        if (merged[i].quantity > INT_MAX - p->stock) {
+            rejected++;
+            merged[i].unapplied = MANIFEST_OVERFLOW;
+            continue;
+        }
+
+        traceRestock(p->id, (int)merged[i].quantity);
+        p->stock += (int)merged[i].quantity;
+        if (merged[i].hasPrice) {
+            traceSetPrice(p->id, merged[i].price);
+            p->price = merged[i].price;
+            pricesUpdated++;
+        }
+        p->lowStockFlag = isLowStock(p, today);
+        unitsAdded += merged[i].quantity;
+        applied++;
+    }
+    cursorFree(&c);
+    double totalSecs = (nowNanos() - start) / 1e9;
+
+    FILE *out = fopen(summaryPath, "w");
+    if (out == NULL)
+        printf("Unable to write summary %s.\n", summaryPath);
+    FILE *targets[2] = { stdout, out };
+    for (int t = 0; t < 2; t++) {
+        if (targets[t] == NULL) continue;
+        fprintf(targets[t], "\n=== BULK RESTOCK SUMMARY ===\n");
+        fprintf(targets[t], "Manifest: %s (%ld bytes, %d parser threads)\n", path, size, numChunks);
+        fprintf(targets[t], "Lines: %d | Malformed: %d | Distinct Products: %d\n", lines, malformed, count);
+        fprintf(targets[t], "Restocked: %d products | Units Added: %lld | Prices Updated: %d\n",
+                applied, unitsAdded, pricesUpdated);
+        fprintf(targets[t], "Unknown IDs: %d | Rejected (stock overflow): %d\n", unknown, rejected);
+        fprintf(targets[t], "Time: %.3f s read + parse + merge, %.3f s total\n", parseSecs, totalSecs);
+    }
+    if (out != NULL) {
+        if (unknown > 0 || rejected > 0) {
+            fprintf(out, "\n--- Unapplied Lines (by product ID) ---\n");
+            for (int k = 0; k < count; k++) {
+                if (merged[k].unapplied == MANIFEST_UNKNOWN_ID)
+                    fprintf(out, "Unknown ID: %d | Quantity: %lld\n", merged[k].id, merged[k].quantity);
+                else if (merged[k].unapplied == MANIFEST_OVERFLOW)
+                    fprintf(out, "Stock overflow: %d | Quantity: %lld\n", merged[k].id, merged[k].quantity);
+            }
+        }
+        fclose(out);
+        printf("Summary written to %s\n", summaryPath);
+    }
+
+    free(merged);
+    return 1;
+}
@@ -2,11 +2,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <limits.h>
 #include "miniproj.h"
 
-// Global variables
-struct Product* root = NULL;
-
 int safeIntInput() {
     int value;
     while (1) {
@@ -57,16 +55,6 @@ int safePositiveIntInput() {
     }
 }
 
-// Helper function to count low stock products
-int countLowStockProducts(struct Product* root) {
-    if (root == NULL) return 0;
-    int count = 0;
-    count += countLowStockProducts(root->left);
-    if (root->lowStockFlag) count++;
-    count += countLowStockProducts(root->right);
-    return count;
-}
-
 // ---------------------- CORE FUNCTION IMPLEMENTATIONS ----------------------
 //creating a node and inserting into BST
 void addProduct() {
@@ -77,7 +65,7 @@ void addProduct() {
     printf("Enter Product ID: ");
     id = safeIntInput();
 
-    struct Product *exists = searchBST(root, id);
+    struct Product *exists = searchBST(activeWarehouse->root, id);
     if (exists != NULL) {
         printf("Product ID %d already exists! Cannot add duplicate.\n", id);
         return;
@@ -92,12 +80,11 @@ void addProduct() {
         printf("Enter Supplier Name: ");
         scanf(" %[^\n]", supplier);
 
-    root = insertBST(root, id, name, stock, price,supplier);
+    activeWarehouse->root = insertBST(activeWarehouse->root, id, name, stock, price,supplier);
     printf("Product added successfully!\n");
     
-    struct Product *p = searchBST(root, id);
-    if (p && p->stock < LOW_STOCK_THRESHOLD) {
-        p->lowStockFlag = 1;
+    struct Product *p = searchBST(activeWarehouse->root, id);
+    if (p && p->lowStockFlag) {
         printf("Low stock alert for new product!\n");
     }
 }
@@ -107,14 +94,22 @@ void searchProduct() {
     printf("Enter Product ID to search: ");
     id = safeIntInput();
 
-    struct Product *p = searchBST(root, id);
+    struct Product *p = searchBST(activeWarehouse->root, id);
     if (p) {
         printf("\n=== PRODUCT DETAILS ===\n");
         printf("ID: %d\n", p->id);
-        printf("Name: %s\n", p->name);
+        printf("Name: %s\n", stringOf(p->name));
         printf("Stock: %d\n", p->stock);
         printf("Price: $%.2f\n", p->price);
-        printf("Status: %s\n", p->lowStockFlag ? "LOW STOCK" : "In Stock");
+        int today = todaySalesDay();
+        printf("Status: %s\n", isLowStock(p, today) ? "LOW STOCK" : "In Stock");
+        float daysLeft = daysOfStock(p, today);
+        printf("Sales Velocity: %.2f units/day\n", currentVelocity(p, today));
+        printf("Reorder Point: %d\n", reorderPoint(p, today));
+        if (daysLeft < 0)
+            printf("Days of Stock: n/a (no recent sales)\n");
+        else
+            printf("Days of Stock: %.1f\n", daysLeft);
         printf("=======================\n");
     } else {
         printf("Product not found!\n");
@@ -130,14 +125,14 @@ void updateProductMenu() {
     printf("Enter Product ID to update: ");
     id = safeIntInput();
     
-    struct Product *p = searchBST(root, id);
+    struct Product *p = searchBST(activeWarehouse->root, id);
     if (!p) {
         printf("Product not found!\n");
         return;
     }
     
     printf("\nCurrent Details:\n");
-    printf("Name: %s | Stock: %d | Price: $%.2f |Supplier Name: %s \n ", p->name, p->stock, p->price,p->supplier);
+    printf("Name: %s | Stock: %d | Price: $%.2f |Supplier Name: %s \n ", stringOf(p->name), p->stock, p->price,stringOf(p->supplier));
     
     printf("\nWhat would you like to update?\n");
     printf("1. Update Name\n");
@@ -152,18 +147,17 @@ void updateProductMenu() {
         case 1:
             printf("Enter new name: ");
             scanf(" %[^\n]", newName);
-            strcpy(p->name, newName);
+            applyProductUpdate(id, internString(newName), p->stock, p->price, p->supplier);
             break;
         case 2:
             printf("Enter new stock quantity: ");
                 newStock = safePositiveIntInput();
-            p->stock = newStock;
-            p->lowStockFlag = (newStock < LOW_STOCK_THRESHOLD) ? 1 : 0;
+            applyProductUpdate(id, p->name, newStock, p->price, p->supplier);
             break;
         case 3:
             printf("Enter new price: ");
             newPrice = safeNonNegativeFloatInput();
-            p->price = newPrice;
+            applyProductUpdate(id, p->name, p->stock, newPrice, p->supplier);
             break;
         case 4:
             printf("Enter new name: ");
@@ -172,15 +166,12 @@ void updateProductMenu() {
                 newStock = safePositiveIntInput();
             printf("Enter new price: ");
             newPrice = safeNonNegativeFloatInput();
-            strcpy(p->name, newName);
-            p->stock = newStock;
-            p->price = newPrice;
-            p->lowStockFlag = (newStock < LOW_STOCK_THRESHOLD) ? 1 : 0;
+            applyProductUpdate(id, internString(newName), newStock, newPrice, p->supplier);
             break;
         case 5:
                 printf("Enter new supplier name: ");
                 scanf(" %[^\n]", newSupplier);
-                strcpy(p->supplier, newSupplier);
+                applyProductUpdate(id, p->name, p->stock, p->price, internString(newSupplier));
             break;
         default:
             printf("Invalid choice!\n");
@@ -194,17 +185,17 @@ void deleteProduct() {
     printf("Enter Product ID to delete: ");
     id = safeIntInput();
     
-    struct Product *p = searchBST(root, id);
+    struct Product *p = searchBST(activeWarehouse->root, id);
     if (!p) {
         printf("Product not found!\n");
         return;
     }
     
-    printf("Are you sure you want to delete '%s' (ID: %d)? (1=Yes, 0=No): ", p->name, p->id);
+    printf("Are you sure you want to delete '%s' (ID: %d)? (1=Yes, 0=No): ", stringOf(p->name), p->id);
     int confirm = safeIntInput();
     
     if (confirm) {
-        root = deleteProductBST(root, id);
+        activeWarehouse->root = deleteProductBST(activeWarehouse->root, id);
         printf("Product deleted successfully!\n");
     } else {
         printf("Deletion cancelled.\n");
@@ -212,8 +203,8 @@ void deleteProduct() {
 }
 
 void displayInventoryStats() {
-    int totalProducts = countProducts(root);
-    int lowStockCount = countLowStockProducts(root);
+    int totalProducts = countProducts(activeWarehouse->root);
+    int lowStockCount = countLowStockProducts(activeWarehouse->root);
     
     printf("\n=== INVENTORY STATISTICS ===\n");
     printf("Total Products: %d\n", totalProducts);
@@ -228,7 +219,7 @@ void restockProduct() {
     printf("Enter Product ID to restock: ");
     id = safeIntInput();
     
-    struct Product *p = searchBST(root, id);
+    struct Product *p = searchBST(activeWarehouse->root, id);
     if (!p) {
         printf("Product not found!\n");
         return;
@@ -243,35 +234,73 @@ void restockProduct() {
         return;
     }
     
-    p->stock += quantity;
-    p->lowStockFlag = (p->stock < LOW_STOCK_THRESHOLD) ? 1 : 0;
-    
+    applyRestock(id, quantity);
     printf("Restocked successfully! New stock: %d\n", p->stock);
 }
 
+// Adds quantity to a product's stock and refreshes its low stock flag.
+// Returns the product, or NULL if the ID is not in the active warehouse.
+struct Product* applyRestock(int id, int quantity) {
+    traceRestock(id, quantity);
+    struct Product *p = searchBST(activeWarehouse->root, id);
+    if (p) {
+        p->stock += quantity;
+        p->lowStockFlag = isLowStock(p, todaySalesDay());
+    }
+    return p;
+}
+
+// Restocks the active warehouse from a supplier manifest file
+void bulkRestock() {
+    char path[260], summaryPath[280];
+
+    printf("Enter manifest file name: ");
+    scanf(" %259[^\n]", path);
+    snprintf(summaryPath, sizeof(summaryPath), "%s.summary.txt", path);
+    bulkRestockFromManifest(path, summaryPath);
+}
+
+// Replaces a product's name, stock, price and supplier and refreshes its low
+// stock flag. Returns the product, or NULL if the ID is not in the active
+// warehouse.
+struct Product* applyProductUpdate(int id, StrId name, int stock, float price, StrId supplier) {
+    traceUpdateProduct(id, stringOf(name), stock, price, stringOf(supplier));
+    struct Product *p = searchBST(activeWarehouse->root, id);
+    if (p) {
+        p->name = name;
+        p->stock = stock;
+        p->price = price;
+        p->supplier = supplier;
+        p->lowStockFlag = isLowStock(p, todaySalesDay());
+    }
+    return p;
+}
+
 void updateStockAfterDispatch(int id, int quantity) {
-    struct Product *p = searchBST(root, id);
+    traceDispatch(id, quantity);
+    struct Product *p = searchBST(activeWarehouse->root, id);
     if (p) {
         if (p->stock >= quantity) {
             p->stock -= quantity;
             
-            time_t t = time(NULL);
-            struct tm tm = *localtime(&t);
+            int today = todaySalesDay();
             char date[20];
-            sprintf(date, "%02d-%02d-%04d", tm.tm_mday, tm.tm_mon + 1, tm.tm_year + 1900);
+            formatSalesDate(today, date);
             
             addSalesRecord(id, p->name, quantity, quantity * p->price, date);
+            recordSaleVelocity(p, quantity, today);
+            rankRecordSale(p, quantity, quantity * p->price);
             
             printf("Updated stock for %s (ID: %d): %d units left.\n",
-                   p->name, p->id, p->stock);
+                   stringOf(p->name), p->id, p->stock);
             
-            p->lowStockFlag = (p->stock < LOW_STOCK_THRESHOLD) ? 1 : 0;
+            p->lowStockFlag = isLowStock(p, today);
             
             if (p->lowStockFlag)
-                printf("Low stock alert for product %s (ID: %d)\n", p->name, p->id);
+                printf("Low stock alert for product %s (ID: %d)\n", stringOf(p->name), p->id);
         } else {
             printf("Insufficient stock for %s (ID: %d). Available: %d, Required: %d\n", 
-                   p->name, p->id, p->stock, quantity);
+                   stringOf(p->name), p->id, p->stock, quantity);
         }
     } else {
         printf("Product not found in inventory!\n");
@@ -286,7 +315,12 @@ void generateReports() {
         printf("2. Low Stock Report\n");
         printf("3. Inventory Report\n");
         printf("4. Financial Summary\n");
-        printf("5. Back to Main Menu\n");
+        printf("5. Archive Sales History\n");
+        printf("6. Archived Sales Report\n");
+        printf("7. Archive Statistics\n");
+        printf("8. Replenishment Suggestions\n");
+        printf("9. Top Sellers\n");
+        printf("10. Back to Main Menu\n");
         printf("Enter choice: ");
         choice = safeIntInput();
         
@@ -296,25 +330,100 @@ void generateReports() {
                 break;
             case 2:
                 printf("\n=== LOW STOCK REPORT ===\n");
-                displayLowStock(root);
+                displayLowStock(activeWarehouse->root);
                 break;
             case 3:
                 printf("\n=== COMPLETE INVENTORY ===\n");
-                inorderBST(root);
+                inorderBST(activeWarehouse->root);
                 break;
             case 4:
                 printf("\n=== FINANCIAL SUMMARY ===\n");
                 printf("Total Revenue: $%.2f\n", calculateTotalRevenue());
-                printf("Total Products: %d\n", countProducts(root));
+                printf("Total Products: %d\n", countProducts(activeWarehouse->root));
                 printf("Pending Orders: %d\n", countPendingOrders());
                 break;
             case 5:
+                archiveSalesHistory();
+                break;
+            case 6:
+                displayArchivedSalesReport();
+                break;
+            case 7:
+                displayArchiveStats();
+                break;
+            case 8:
+                printf("\n=== REPLENISHMENT SUGGESTIONS ===\n");
+                displayReplenishmentSuggestions(activeWarehouse->root);
+                break;
+            case 9:
+                printf("How many top products to show? ");
+                displayTopSellers(safePositiveIntInput());
+                break;
+            case 10:
+                printf("Returning to Main Menu...\n");
+                break;
+            default:
+                printf("Invalid choice!\n");
+        }
+    } while(choice != 10);
+}
+
+// Pages through the product list INVENTORY_PAGE_SIZE products at a time
+void browseInventory() {
+    struct Product *page[INVENTORY_PAGE_SIZE], *next[INVENTORY_PAGE_SIZE];
+    int count, found, choice;
+
+    count = productPage(activeWarehouse->root, INT_MIN, INVENTORY_PAGE_SIZE, 0, page);
+    if (count == 0) {
+        printf("\n--- PRODUCT INVENTORY ---\n");
+        printf("No products in inventory.\n");
+        return;
+    }
+
+    do {
+        printf("\n--- PRODUCT INVENTORY ---\n");
+        for (int i = 0; i < count; i++)
+            printProductLine(page[i]);
+        if (count > 0)
+            printf("Showing %d products (ID %d to %d)\n", count, page[0]->id, page[count - 1]->id);
+        else
+            printf("No products in this range.\n");
+
+        printf("\n1. Next Page\n");
+        printf("2. Previous Page\n");
+        printf("3. Show Products After ID\n");
+        printf("4. Back to Main Menu\n");
+        printf("Enter choice: ");
+        choice = safeIntInput();
+
+        switch (choice) {
+            case 1:
+            case 2:
+                if (count == 0) {
+                    found = productPage(activeWarehouse->root, INT_MIN, INVENTORY_PAGE_SIZE, 0, next);
+                } else if (choice == 1) {
+                    found = productPage(activeWarehouse->root, page[count - 1]->id, INVENTORY_PAGE_SIZE, 0, next);
+                } else {
+                    found = productPage(activeWarehouse->root, page[0]->id, INVENTORY_PAGE_SIZE, 1, next);
+                }
+                if (found == 0) {
+                    printf(choice == 1 ? "Already at the last page.\n" : "Already at the first page.\n");
+                } else {
+                    memcpy(page, next, sizeof(struct Product*) * found);
+                    count = found;
+                }
+                break;
+            case 3:
+                printf("Enter Product ID: ");
+                count = productPage(activeWarehouse->root, safeIntInput(), INVENTORY_PAGE_SIZE, 0, page);
+                break;
+            case 4:
                 printf("Returning to Main Menu...\n");
                 break;
             default:
                 printf("Invalid choice!\n");
         }
-    } while(choice != 5);
+    } while (choice != 4);
 }
 
 void ordersPlaced() {
@@ -322,15 +431,21 @@ void ordersPlaced() {
     char customerName[50];
 
     do {
+        struct Product *page[INVENTORY_PAGE_SIZE];
+        int shown = productPage(activeWarehouse->root, INT_MIN, INVENTORY_PAGE_SIZE, 0, page);
         printf("Current inventory details:\n");
-        inorderBST(root);
+        for (int i = 0; i < shown; i++)
+            printProductLine(page[i]);
+        if (shown == INVENTORY_PAGE_SIZE)
+            printf("(first %d products; use Display All Products to browse the rest)\n", shown);
         printf("\n--- Order Management System ---\n");
         printf("1. New Order\n");
         printf("2. Dispatch Highest Priority Order\n");
         printf("3. View Pending Orders\n");
         printf("4. Order Statistics\n");
         printf("5. Clear All Orders\n");
-        printf("6. Exit to Main Menu\n");
+        printf("6. Dispatch All Warehouses (parallel)\n");
+        printf("7. Exit to Main Menu\n");
         printf("Enter choice: ");
         choice = safeIntInput();
 
@@ -350,8 +465,14 @@ void ordersPlaced() {
                     break;
                 }
                 
-                if (searchBST(root, pid)) {
+                // Route to the site that can fill the order
+                struct Warehouse *site = routeOrder(pid, quantity);
+                if (site) {
+                    struct Warehouse *prev = selectWarehouse(site);
                     insertPQ(pid, quantity, prio, customerName);
+                    selectWarehouse(prev);
+                    if (warehouseCount() > 1)
+                        printf("Routed to warehouse: %s\n", stringOf(site->name));
                 } else {
                     printf("Invalid Product ID. Product not found in inventory.\n");
                 }
@@ -363,7 +484,7 @@ void ordersPlaced() {
                     printf("No orders to dispatch.\n");
                 } else {
                     printf("\n=== DISPATCHING ORDER ===\n");
-                    printf("Customer: %s\n", dispatched->customerName);
+                    printf("Customer: %s\n", stringOf(dispatched->customerName));
                     printf("Product ID: %d | Quantity: %d | Priority: %d\n",
                            dispatched->productId, dispatched->quantity, dispatched->priority);
                     printf("==========================\n");
@@ -387,21 +508,121 @@ void ordersPlaced() {
                 break;
 
             case 6:
+                printf("Total Dispatched: %d orders\n", dispatchAllWarehouses());
+                break;
+
+            case 7:
                 printf("Returning to Main Menu...\n");
                 break;
 
             default:
                 printf("Invalid option.\n");
         }
-    } while (choice != 6);
+    } while (choice != 7);
+}
+
+void manageWarehouses() {
+    int choice, id, preference;
+    char name[50];
+
+    do {
+        displayWarehouses();
+        printf("\n--- Warehouse Management ---\n");
+        printf("1. Add Warehouse\n");
+        printf("2. Switch Active Warehouse\n");
+        printf("3. Set Routing Preference\n");
+        printf("4. Exit to Main Menu\n");
+        printf("Enter choice: ");
+        choice = safeIntInput();
+
+        switch (choice) {
+            case 1: {
+                printf("Enter Warehouse Name: ");
+                scanf(" %[^\n]", name);
+                printf("Enter Routing Preference (lower = preferred): ");
+                preference = safeIntInput();
+                struct Warehouse *w = createWarehouse(name, preference);
+                if (w)
+                    printf("Warehouse %s added with ID %d.\n", stringOf(w->name), w->id);
+                break;
+            }
+
+            case 2: {
+                printf("Enter Warehouse ID: ");
+                id = safeIntInput();
+                struct Warehouse *w = findWarehouse(id);
+                if (w) {
+                    selectWarehouse(w);
+                    printf("Active warehouse: %s\n", stringOf(w->name));
+                } else {
+                    printf("Warehouse not found!\n");
+                }
+                break;
+            }
+
+            case 3: {
+                printf("Enter Warehouse ID: ");
+                id = safeIntInput();
+                struct Warehouse *w = findWarehouse(id);
+                if (w) {
+                    printf("Enter Routing Preference (lower = preferred): ");
+                    w->preference = safeIntInput();
+                    printf("Preference updated.\n");
+                } else {
+                    printf("Warehouse not found!\n");
+                }
+                break;
+            }
+
+            case 4:
+                printf("Returning to Main Menu...\n");
+                break;
+
+            default:
+                printf("Invalid option.\n");
+        }
+    } while (choice != 4);
+}
+
+// Starts or stops recording core operations to a trace file
+void traceRecording() {
+    char path[260];
+
+    if (traceActive()) {
+        long ops = traceStop();
+        printf("Trace stopped: %ld operations recorded.\n", ops);
+        printf("State Checksum: %016llx\n", stateChecksum());
+        return;
+    }
+
+    printf("Enter trace file name: ");
+    scanf(" %259[^\n]", path);
+    if (traceStart(path))
+        printf("Recording operations to %s. Choose this option again to stop.\n", path);
 }
 
 int main(int argc, char* argv[]) {
     int choice;
     int cfgLow = 5;
     int cfgMaxHistory = 100;
+    int cfgLeadDays = 7;
+    const char *archivePath = NULL;
+
+    // Replay mode: program --replay <trace_file> [paced]
+    if (argc >= 3 && strcmp(argv[1], "--replay") == 0) {
+        int paced = argc >= 4 && strcmp(argv[3], "paced") == 0;
+        // Core functions report every step on stdout; keep only the summary
+#ifdef _WIN32
+        freopen("NUL", "w", stdout);
+#else
+        freopen("/dev/null", "w", stdout);
+#endif
+        return replayTrace(argv[2], paced);
+    }
 
-    // Parse command-line arguments: program <low_stock_threshold> <max_history>
+    // Parse command-line arguments:
+    // program <low_stock_threshold> <max_history> <sales_archive_file> <lead_time_days>
+    // Pass "-" as the archive file to set the lead time without keeping an archive.
     if (argc >= 2) {
         int v = atoi(argv[1]);
         if (v > 0) cfgLow = v;
@@ -410,15 +631,40 @@ int main(int argc, char* argv[]) {
         int v = atoi(argv[2]);
         if (v > 0) cfgMaxHistory = v;
     }
+    if (argc >= 4 && strcmp(argv[3], "-") != 0) {
+        archivePath = argv[3];
+    }
+    if (argc >= 5) {
+        int v = atoi(argv[4]);
+        if (v > 0) cfgLeadDays = v;
+    }
 
-    // Initialize runtime configuration (allocates sales history)
-    initConfig(cfgLow, cfgMaxHistory);
+    // Initialize runtime configuration
+    initConfig(cfgLow, cfgMaxHistory, cfgLeadDays);
+
+    // Start with a single site; more can be added from the warehouse menu
+    struct Warehouse *mainSite = createWarehouse("Main", 0);
+    if (mainSite == NULL)
+        return 1;
+
+    // Load previously archived sales of every site, if an archive file was
+    // given. Sites saved in an earlier run are recreated. An archive that
+    // exists but cannot be loaded is never saved over.
+    int archiveLoaded = 1;
+    if (archivePath != NULL) {
+        archiveLoaded = loadSalesArchive(archivePath);
+        long loaded = 0;
+        for (int i = 0; i < warehouseCount(); i++)
+            loaded += findWarehouse(i)->archive.rows;
+        if (archiveLoaded && loaded > 0)
+            printf("Loaded %ld archived sales from %s\n", loaded, archivePath);
+    }
 
     printf("====== SUPPLY CHAIN MANAGEMENT SYSTEM ======\n");
     printf("           Warehouse Management v2.0        \n\n");
 
     do {
-        printf("\n--- MAIN MENU ---\n");
+        printf("\n--- MAIN MENU (Warehouse: %s) ---\n", stringOf(activeWarehouse->name));
         printf("1. Add Product\n");
         printf("2. Search Product\n");
         printf("3. Update Product\n");
@@ -428,7 +674,10 @@ int main(int argc, char* argv[]) {
         printf("7. Restock Product\n");
         printf("8. Generate Reports\n");
         printf("9. Inventory Statistics\n");
-        printf("10. Exit\n");
+        printf("10. Manage Warehouses\n");
+        printf("11. %s Trace Recording\n", traceActive() ? "Stop" : "Start");
+        printf("12. Bulk Restock from Manifest\n");
+        printf("13. Exit\n");
         printf("Enter your choice: ");
         choice = safeIntInput();
 
@@ -446,11 +695,7 @@ int main(int argc, char* argv[]) {
                 deleteProduct();
                 break;
             case 5:
-                printf("\n--- PRODUCT INVENTORY ---\n");
-                if (root == NULL)
-                    printf("No products in inventory.\n");
-                else
-                    inorderBST(root);
+                browseInventory();
                 break;
             case 6:
                 ordersPlaced();
@@ -465,12 +710,38 @@ int main(int argc, char* argv[]) {
                 displayInventoryStats();
                 break;
             case 10:
+                manageWarehouses();
+                break;
+            case 11:
+                traceRecording();
+                break;
+            case 12:
+                bulkRestock();
+                break;
+            case 13:
                 printf("Exiting system... Thank you!\n");
                 break;
             default:
                 printf("Invalid choice. Please try again.\n");
         }
-    } while (choice != 10);
+    } while (choice != 13);
+
+    if (traceActive()) {
+        long ops = traceStop();
+        printf("Trace stopped: %ld operations recorded. State Checksum: %016llx\n", ops, stateChecksum());
+    }
+
+    // Seal every site's remaining sales and persist all archives
+    if (archivePath != NULL && !archiveLoaded) {
+        printf("Sales archive not saved: %s could not be loaded and was left untouched.\n", archivePath);
+    } else if (archivePath != NULL) {
+        for (int i = 0; i < warehouseCount(); i++) {
+            selectWarehouse(findWarehouse(i));
+            if (activeWarehouse->salesCount > 0)
+                archiveSalesHistory();
+        }
+        saveSalesArchive(archivePath);
+    }
 
     return 0;
 }
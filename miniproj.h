@@ -2,23 +2,59 @@
 #define WAREHOUSE_H
 
 #include <stddef.h>
+#include <stdio.h>
+
+// Rows per sealed sales archive block
+#define ARCHIVE_BLOCK_ROWS 1024
+// Columns stored per archive block (day, product, quantity, cents, name)
+#define SALES_ARCHIVE_COLUMNS 5
+
+// Smoothing factor for the per-product sales velocity EWMA
+#define VELOCITY_ALPHA 0.3f
+// Service-level factor for reorder safety stock (~95%)
+#define REORDER_SAFETY_Z 1.65f
+
+// Best seller ranking metrics (see salesrank.c)
+#define RANK_BY_UNITS 0
+#define RANK_BY_REVENUE 1
+#define RANK_METRICS 2
 
 // Runtime-configurable settings (set via command-line args)
 extern int LOW_STOCK_THRESHOLD; // Threshold for low stock alerts
 extern int MAX_HISTORY;         // Maximum sales records to store
+extern int REORDER_LEAD_DAYS;   // Supplier lead time used for reorder points
+
+// Products shown per page when browsing the inventory
+#define INVENTORY_PAGE_SIZE 50
+
+// Maximum number of warehouse sites in one process
+#define MAX_WAREHOUSES 16
+
+// Maximum parser threads for a bulk restock manifest
+#define MANIFEST_MAX_THREADS 8
+
+// Handle to a deduplicated string in the string pool (see strpool.c)
+typedef unsigned int StrId;
 
 // ---------------------- STRUCT DEFINITIONS ----------------------
 
 // Represents a product in the warehouse inventory
 struct Product {
     int id;                     // Unique product identifier
-    char name[50];              // Product name
+    StrId name;                 // Product name (interned)
     int stock;                  // Current stock quantity
     float price;                // Product price
-    int lowStockFlag;           // Flag indicating low stock (1 = low, 0 = normal)
+    int lowStockFlag;           // 1 = at or below reorder point as of the last change, 0 = normal
     struct Product *left;       // Pointer to left child in BST
     struct Product *right;      // Pointer to right child in BST    
-    char supplier[50];          // Supplier name
+    StrId supplier;             // Supplier name (interned)
+    float velocity;             // EWMA of units sold per day (completed days)
+    float velocityVar;          // EWMA variance of daily units sold
+    int unitsToday;             // Units sold on lastSaleDay, not yet folded into velocity
+    int lastSaleDay;            // Day of the most recent sale (-1 = never sold)
+    long long totalUnitsSold;   // Cumulative units sold
+    double totalRevenue;        // Cumulative sales revenue
+    int rankPos[RANK_METRICS];  // Slot in each best seller heap (-1 = untracked)
 };
 
 // Represents a customer order in the priority queue
@@ -26,19 +62,71 @@ struct Order {
     int productId;              // ID of the product being ordered
     int quantity;               // Quantity requested
     int priority;               // Order priority (1-10, higher = more urgent)
-    char customerName[50];      // Name of the customer who placed the order
+    StrId customerName;         // Name of the customer who placed the order (interned)
     struct Order *next;         // Pointer to next order in the queue
 };
 
 // Stores sales transaction history
 struct SalesRecord {
     int productId;              // ID of the sold product
-    char productName[50];       // Name of the sold product
+    StrId productName;          // Name of the sold product (interned)
     int quantitySold;           // Quantity sold in this transaction
     float totalAmount;          // Total sale amount (quantity * price)
     char date[20];              // Date of the sale transaction
 };
 
+// Resumable in-order cursor over a product BST (see helper.c)
+struct ProductCursor {
+    struct Product **path;      // Nodes from the root down to the current product
+    int depth;                  // Path length (0 = cursor exhausted)
+    int cap;                    // Allocated path slots
+};
+
+// Sealed, columnar block of archived sales (see salesarchive.c)
+struct SalesBlock {
+    int rowCount;               // Number of sales in this block
+    int minDay, maxDay;         // Date range covered (days since 1970-01-01)
+    int minProduct, maxProduct; // Product ID range covered
+    long long totalCents;       // Revenue of the block in cents
+    int dictCount;              // Distinct product names in the block
+    StrId *dict;                // Block-local product name dictionary
+    unsigned char *data;        // Encoded columns, back to back
+    size_t colOffset[SALES_ARCHIVE_COLUMNS + 1]; // Start of each column in data
+};
+
+// All sealed sales blocks of one warehouse
+struct SalesArchive {
+    struct SalesBlock *blocks;  // Sealed blocks, oldest first
+    int blockCount;
+    int blockCap;
+    long rows;                  // Rows across all blocks
+    long long cents;            // Revenue across all blocks
+};
+
+// Best seller heaps of one warehouse (see salesrank.c)
+struct SalesRanking {
+    struct Product **heap[RANK_METRICS]; // Heap arrays, one per metric
+    int size;                   // Products tracked (same for every heap)
+    int cap;
+};
+
+// One warehouse site with its own product index, order queue and sales log
+struct Warehouse {
+    int id;                     // Site number (index in the warehouse registry)
+    StrId name;                 // Site name (interned)
+    int preference;             // Routing preference (lower = preferred)
+    struct Product *root;       // Root of the product BST
+    struct Order *front;        // Front of the pending order queue
+    struct SalesRecord *salesHistory; // In-memory sales log (size = MAX_HISTORY)
+    int salesCount;             // Sales records currently held in memory
+    struct SalesArchive archive;  // Compressed historical sales
+    struct SalesRanking ranking;  // Best seller heaps
+};
+
+// Warehouse the calling thread is working on. Each dispatch worker sets its
+// own; the menu thread switches it with selectWarehouse.
+extern _Thread_local struct Warehouse *activeWarehouse;
+
 // ---------------------- BST FUNCTION DECLARATIONS ----------------------
 
 struct Product* insertBST(struct Product*, int, char[], int, float,char []);
@@ -47,7 +135,39 @@ void inorderBST(struct Product*);
 struct Product* findMin(struct Product*);
 struct Product* deleteProductBST(struct Product*, int);
 int countProducts(struct Product*);
+int countLowStockProducts(struct Product*);
 void displayLowStock(struct Product*);
+void printProductLine(struct Product*);
+
+// ---------------------- PRODUCT CURSOR FUNCTIONS ----------------------
+
+void cursorInit(struct ProductCursor *c);
+void cursorFree(struct ProductCursor *c);
+struct Product* cursorCurrent(struct ProductCursor *c);
+struct Product* cursorSeek(struct ProductCursor *c, struct Product *root, int id);
+struct Product* cursorFirst(struct ProductCursor *c, struct Product *root);
+struct Product* cursorLast(struct ProductCursor *c, struct Product *root);
+struct Product* cursorNext(struct ProductCursor *c);
+struct Product* cursorPrev(struct ProductCursor *c);
+int productPage(struct Product *root, int anchorId, int pageSize, int backward, struct Product **out);
+
+// ---------------------- SALES VELOCITY FUNCTIONS ----------------------
+
+void recordSaleVelocity(struct Product *p, int quantity, int day);
+float currentVelocity(const struct Product *p, int today);
+int reorderPoint(const struct Product *p, int today);
+int isLowStock(const struct Product *p, int today);
+float daysOfStock(const struct Product *p, int today);
+void displayReplenishmentSuggestions(struct Product *root);
+
+// ---------------------- BEST SELLER RANKING FUNCTIONS ----------------------
+
+void rankTrackProduct(struct Product *p);
+void rankUntrackProduct(struct Product *p);
+void rankMoveProduct(struct Product *from, struct Product *to);
+void rankRecordSale(struct Product *p, int units, float revenue);
+int topSellers(int metric, int k, struct Product **out);
+void displayTopSellers(int k);
 
 // ---------------------- PRIORITY QUEUE FUNCTION DECLARATIONS ----------------------
 
@@ -55,14 +175,74 @@ void insertPQ(int id, int quantity, int priority, char customerName[]);
 struct Order* deleteMax();
 void displayOrders();
 int countPendingOrders();
+int pendingQuantity(int productId);
 void clearAllOrders();
+void clearOrders();
 
 // ---------------------- SALES HISTORY FUNCTIONS ----------------------
 
-void addSalesRecord(int id, char name[], int quantity, float amount, char date[]);
+void addSalesRecord(int id, StrId name, int quantity, float amount, char date[]);
 void displaySalesReport();
 float calculateTotalRevenue();
 
+// ---------------------- SALES ARCHIVE FUNCTIONS ----------------------
+
+int archiveSalesRecords(const struct SalesRecord *rows, int count);
+long scanSalesArchive(int fromDay, int toDay, int productId,
+                      void (*visit)(const struct SalesRecord*, void*), void *ctx);
+float archivedRevenue();
+long archivedSalesCount();
+int writeSalesArchive(FILE *f);
+int readSalesArchive(FILE *f, const char *name);
+int saveSalesArchive(const char *path);
+int loadSalesArchive(const char *path);
+int parseSalesDate(const char *date, int *day);
+void formatSalesDate(int days, char out[20]);
+int todaySalesDay();
+void archiveSalesHistory();
+void displayArchivedSalesReport();
+void displayArchiveStats();
+
+// ---------------------- WAREHOUSE FUNCTIONS ----------------------
+
+struct Warehouse* createWarehouse(const char *name, int preference);
+struct Warehouse* findWarehouse(int id);
+int warehouseCount();
+struct Warehouse* selectWarehouse(struct Warehouse *w);
+struct Warehouse* routeOrder(int productId, int quantity);
+int dispatchAllWarehouses();
+void displayWarehouses();
+
+// ---------------------- BULK RESTOCK FUNCTIONS ----------------------
+
+int bulkRestockFromManifest(const char *path, const char *summaryPath);
+
+// ---------------------- TRACE RECORD / REPLAY FUNCTIONS ----------------------
+
+int traceStart(const char *path);
+long traceStop();
+int traceActive();
+void traceCreateWarehouse(const char *name, int preference);
+void traceInsertProduct(int id, const char *name, int stock, float price, const char *supplier);
+void traceDeleteProduct(int id);
+void traceInsertOrder(int id, int quantity, int priority, const char *customerName);
+void traceDeleteMax();
+void traceDispatch(int id, int quantity);
+void traceRestock(int id, int quantity);
+void traceSetPrice(int id, float price);
+void traceUpdateProduct(int id, const char *name, int stock, float price, const char *supplier);
+void traceClearOrders();
+void traceArchiveSales();
+unsigned long long stateChecksum();
+long long nowNanos();
+int replayTrace(const char *path, int paced);
+
+// ---------------------- STRING POOL FUNCTIONS ----------------------
+
+StrId internString(const char *s);
+const char* stringOf(StrId id);
+unsigned int internedStringCount();
+
 // ---------------------- CORE FUNCTION DECLARATIONS ----------------------
 
 void addProduct();
@@ -73,10 +253,16 @@ void displayInventoryStats();
 void ordersPlaced();
 void updateStockAfterDispatch(int id, int quantity);
 void restockProduct();
+struct Product* applyRestock(int id, int quantity);
+struct Product* applyProductUpdate(int id, StrId name, int stock, float price, StrId supplier);
+void bulkRestock();
+void traceRecording();
 void generateReports();
+void browseInventory();
+void manageWarehouses();
 
 // Initialize runtime configuration (call early from main)
-void initConfig(int lowStockThreshold, int maxHistory);
+void initConfig(int lowStockThreshold, int maxHistory, int leadDays);
 
 // ---------------------- INPUT HELPERS ----------------------
 int safeIntInput();
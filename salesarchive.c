@@ -0,0 +1,770 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include <errno.h>
+#include <pthread.h>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include "miniproj.h"
+
+// ---------------------- SALES ARCHIVE ----------------------
+//
+// Historical sales are kept in sealed, columnar blocks of up to
+// ARCHIVE_BLOCK_ROWS rows. Each column is delta- and/or varint-encoded:
+//   day      - days since 1970-01-01, zigzag delta from the previous row
+//   product  - product ID, zigzag delta from the previous row
+//   quantity - varint
+//   cents    - sale amount in cents, varint
+//   name     - index into the block's local name dictionary, varint
+// Every block records its min/max day and product ID so range queries can
+// skip blocks without decoding them.
+//
+// An archive file holds every warehouse: a version 2 header with the site
+// count, then per site its name, routing preference and a version 1 section
+// with its blocks. Older version 1 files hold one site's blocks only.
+
+#define ARCHIVE_MAGIC "WHSA"
+#define ARCHIVE_VERSION 1
+#define ARCHIVE_SITES_VERSION 2
+
+enum { COL_DAY, COL_PRODUCT, COL_QUANTITY, COL_CENTS, COL_NAME };
+
+static volatile double benchSink;        // Keeps benchmark loops from being optimised away
+
+// ---------------------- DATE HELPERS ----------------------
+
+// Days since 1970-01-01 for a civil date (proleptic Gregorian)
+static int daysFromCivil(int y, int m, int d) {
+    y -= m <= 2;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// Inverse of daysFromCivil
+static void civilFromDays(int z, int *y, int *m, int *d) {
+    z += 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int doe = z - era * 146097;
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp = (5 * doy + 2) / 153;
+    *d = doy - (153 * mp + 2) / 5 + 1;
+    *m = mp + (mp < 10 ? 3 : -9);
+    *y = yoe + era * 400 + (*m <= 2);
+}
+
+// Converts a "dd-mm-yyyy" date (years 0..9999) to a day number, which is
+// negative before 1970. Returns 1 on success, 0 if the date is malformed or
+// does not exist (e.g. 31-02-2025).
+int parseSalesDate(const char *date, int *day) {
+    static const int monthDays[12] = { 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    int d, m, y, end = 0;
+    if (sscanf(date, "%d-%d-%d%n", &d, &m, &y, &end) != 3 || date[end] != '\0'
+        || y < 0 || y > 9999 || m < 1 || m > 12 || d < 1 || d > monthDays[m - 1])
+        return 0;
+    int leap = (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+    if (m == 2 && d == 29 && !leap)
+        return 0;
+    *day = daysFromCivil(y, m, d);
+    return 1;
+}
+
+// Formats a day number as "dd-mm-yyyy" (years clamped to 0..9999)
+void formatSalesDate(int days, char out[20]) {
+    int y, m, d;
+    civilFromDays(days, &y, &m, &d);
+    y = y < 0 ? 0 : y > 9999 ? 9999 : y;
+    snprintf(out, 20, "%02d-%02d-%04d", d % 100, m % 100, y);
+}
+
+// Day number of the current local date. localtime() shares one buffer, so
+// dispatch workers take turns.
+int todaySalesDay() {
+    static pthread_mutex_t clockLock = PTHREAD_MUTEX_INITIALIZER;
+    time_t t = time(NULL);
+    pthread_mutex_lock(&clockLock);
+    struct tm tm = *localtime(&t);
+    pthread_mutex_unlock(&clockLock);
+    return daysFromCivil(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday);
+}
+
+// ---------------------- VARINT ENCODING ----------------------
+
+struct ByteBuf {
+    unsigned char *data;
+    size_t len;
+    size_t cap;
+};
+
+static int putByte(struct ByteBuf *b, unsigned char c) {
+    if (b->len == b->cap) {
+        size_t newCap = b->cap ? b->cap * 2 : 256;
+        unsigned char *p = (unsigned char*)realloc(b->data, newCap);
+        if (p == NULL) return 0;
+        b->data = p;
+        b->cap = newCap;
+    }
+    b->data[b->len++] = c;
+    return 1;
+}
+
+static int putVarint(struct ByteBuf *b, unsigned long long v) {
+    while (v >= 0x80) {
+        if (!putByte(b, (unsigned char)(v | 0x80))) return 0;
+        v >>= 7;
+    }
+    return putByte(b, (unsigned char)v);
+}
+
+static unsigned long long getVarint(const unsigned char **p) {
+    unsigned long long v = 0;
+    int shift = 0;
+    while (**p & 0x80) {
+        v |= (unsigned long long)(**p & 0x7f) << shift;
+        shift += 7;
+        (*p)++;
+    }
+    v |= (unsigned long long)**p << shift;
+    (*p)++;
+    return v;
+}
+
+// Like getVarint, but fails instead of reading at or past end or beyond 64 bits
+static int getVarintChecked(const unsigned char **p, const unsigned char *end, unsigned long long *v) {
+    *v = 0;
+    for (int shift = 0; *p < end && shift < 64; shift += 7) {
+        unsigned char b = *(*p)++;
+        *v |= (unsigned long long)(b & 0x7f) << shift;
+        if (!(b & 0x80))
+            return 1;
+    }
+    return 0;
+}
+
+static unsigned long long zigzag(long long v) {
+    return ((unsigned long long)v << 1) ^ (unsigned long long)(v >> 63);
+}
+
+static long long unzigzag(unsigned long long v) {
+    return (long long)(v >> 1) ^ -(long long)(v & 1);
+}
+
+// ---------------------- BLOCK ENCODING ----------------------
+
+static long amountToCents(float amount) {
+    return (long)(amount * 100.0f + 0.5f);
+}
+
+// Decodes one column of a block into out[0..rowCount)
+static void decodeColumn(const struct SalesBlock *blk, int col, long long *out) {
+    const unsigned char *p = blk->data + blk->colOffset[col];
+    long long prev = 0;
+    for (int i = 0; i < blk->rowCount; i++) {
+        unsigned long long v = getVarint(&p);
+        if (col == COL_DAY || col == COL_PRODUCT) {
+            prev += unzigzag(v);
+            out[i] = prev;
+        } else {
+            out[i] = (long long)v;
+        }
+    }
+}
+
+// Appends one row to a block being encoded
+static int putRow(struct SalesBlock *blk, struct ByteBuf *cols, int *prevDay, int *prevProduct,
+                  int day, int productId, int quantity, long long cents, StrId name) {
+    int first = blk->rowCount == 0;
+    if (first || day < blk->minDay) blk->minDay = day;
+    if (first || day > blk->maxDay) blk->maxDay = day;
+    if (first || productId < blk->minProduct) blk->minProduct = productId;
+    if (first || productId > blk->maxProduct) blk->maxProduct = productId;
+    blk->totalCents += cents;
+
+    // Names repeat within a block, so a linear scan of the dictionary is cheap
+    int nameIdx = 0;
+    while (nameIdx < blk->dictCount && blk->dict[nameIdx] != name)
+        nameIdx++;
+    if (nameIdx == blk->dictCount)
+        blk->dict[blk->dictCount++] = name;
+
+    int ok = putVarint(&cols[COL_DAY], zigzag((long long)day - *prevDay))
+          && putVarint(&cols[COL_PRODUCT], zigzag((long long)productId - *prevProduct))
+          && putVarint(&cols[COL_QUANTITY], (unsigned long long)quantity)
+          && putVarint(&cols[COL_CENTS], (unsigned long long)cents)
+          && putVarint(&cols[COL_NAME], (unsigned long long)nameIdx);
+    *prevDay = day;
+    *prevProduct = productId;
+    blk->rowCount++;
+    return ok;
+}
+
+// Encodes the rows of prefix (if not NULL) followed by rows[0..count) into a
+// sealed block
+static int encodeBlock(struct SalesBlock *blk, const struct SalesBlock *prefix,
+                       const struct SalesRecord *rows, int count) {
+    static _Thread_local long long col[SALES_ARCHIVE_COLUMNS][ARCHIVE_BLOCK_ROWS];
+    struct ByteBuf cols[SALES_ARCHIVE_COLUMNS];
+    memset(cols, 0, sizeof(cols));
+    memset(blk, 0, sizeof(*blk));
+
+    int total = count + (prefix ? prefix->rowCount : 0);
+    blk->dict = (StrId*)malloc(sizeof(StrId) * total);
+    if (blk->dict == NULL) return 0;
+
+    int prevDay = 0, prevProduct = 0, ok = 1;
+    if (prefix != NULL) {
+        for (int c = 0; c < SALES_ARCHIVE_COLUMNS; c++)
+            decodeColumn(prefix, c, col[c]);
+        for (int i = 0; i < prefix->rowCount && ok; i++)
+            ok = putRow(blk, cols, &prevDay, &prevProduct, (int)col[COL_DAY][i], (int)col[COL_PRODUCT][i],
+                        (int)col[COL_QUANTITY][i], col[COL_CENTS][i], prefix->dict[col[COL_NAME][i]]);
+    }
+    for (int i = 0; i < count && ok; i++) {
+        int day;
+        if (!parseSalesDate(rows[i].date, &day))
+            day = 0;
+        ok = putRow(blk, cols, &prevDay, &prevProduct, day, rows[i].productId,
+                    rows[i].quantitySold, amountToCents(rows[i].totalAmount), rows[i].productName);
+    }
+
+    size_t bytes = 0;
+    for (int c = 0; c < SALES_ARCHIVE_COLUMNS; c++)
+        bytes += cols[c].len;
+    blk->data = ok ? (unsigned char*)malloc(bytes ? bytes : 1) : NULL;
+
+    if (blk->data != NULL) {
+        size_t off = 0;
+        for (int c = 0; c < SALES_ARCHIVE_COLUMNS; c++) {
+            blk->colOffset[c] = off;
+            memcpy(blk->data + off, cols[c].data, cols[c].len);
+            off += cols[c].len;
+        }
+        blk->colOffset[SALES_ARCHIVE_COLUMNS] = off;
+    }
+
+    for (int c = 0; c < SALES_ARCHIVE_COLUMNS; c++)
+        free(cols[c].data);
+    if (blk->data == NULL) {
+        free(blk->dict);
+        blk->dict = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+// Checks a block read from disk: every column must decode exactly rowCount
+// varints inside its own byte range, name indices must fall inside the
+// dictionary, and the stored min/max and revenue must match the rows.
+static int validateBlock(const struct SalesBlock *blk) {
+    for (int c = 0; c < SALES_ARCHIVE_COLUMNS; c++) {
+        const unsigned char *p = blk->data + blk->colOffset[c];
+        const unsigned char *end = blk->data + blk->colOffset[c + 1];
+        long long prev = 0, cents = 0;
+
+        for (int i = 0; i < blk->rowCount; i++) {
+            unsigned long long v;
+            if (!getVarintChecked(&p, end, &v))
+                return 0;
+            if (c == COL_DAY || c == COL_PRODUCT) {
+                long long delta = unzigzag(v);
+                if (delta < -(1LL << 32) || delta > (1LL << 32))
+                    return 0;
+                prev += delta;
+                if (c == COL_DAY ? (prev < blk->minDay || prev > blk->maxDay)
+                                 : (prev < blk->minProduct || prev > blk->maxProduct))
+                    return 0;
+            } else if (c == COL_QUANTITY) {
+                if (v > INT_MAX) return 0;
+            } else if (c == COL_CENTS) {
+                if (v > LLONG_MAX / ARCHIVE_BLOCK_ROWS) return 0;
+                cents += (long long)v;
+            } else if (v >= (unsigned long long)blk->dictCount) {
+                return 0;
+            }
+        }
+        if (p != end || (c == COL_CENTS && cents != blk->totalCents))
+            return 0;
+    }
+    return 1;
+}
+
+static int appendBlock(const struct SalesBlock *blk) {
+    struct SalesArchive *arc = &activeWarehouse->archive;
+    if (arc->blockCount == arc->blockCap) {
+        int newCap = arc->blockCap ? arc->blockCap * 2 : 16;
+        struct SalesBlock *p = (struct SalesBlock*)realloc(arc->blocks, sizeof(struct SalesBlock) * newCap);
+        if (p == NULL) return 0;
+        arc->blocks = p;
+        arc->blockCap = newCap;
+    }
+    arc->blocks[arc->blockCount++] = *blk;
+    arc->rows += blk->rowCount;
+    arc->cents += blk->totalCents;
+    return 1;
+}
+
+// ---------------------- ARCHIVE API ----------------------
+
+// Seals rows[0..count) into the active warehouse's archive blocks. Rows first
+// top up a partly filled last block, so archiving small batches (every
+// MAX_HISTORY sales) still produces full ARCHIVE_BLOCK_ROWS blocks. Returns the
+// number of rows archived.
+int archiveSalesRecords(const struct SalesRecord *rows, int count) {
+    struct SalesArchive *arc = &activeWarehouse->archive;
+    int done = 0;
+
+    if (count > 0 && arc->blockCount > 0 && arc->blocks[arc->blockCount - 1].rowCount < ARCHIVE_BLOCK_ROWS) {
+        struct SalesBlock *tail = &arc->blocks[arc->blockCount - 1];
+        int n = ARCHIVE_BLOCK_ROWS - tail->rowCount;
+        if (n > count) n = count;
+
+        struct SalesBlock blk;
+        if (!encodeBlock(&blk, tail, rows, n)) {
+            fprintf(stderr, "Sales archive: out of memory\n");
+            return 0;
+        }
+        arc->rows += n;
+        arc->cents += blk.totalCents - tail->totalCents;
+        free(tail->data);
+        free(tail->dict);
+        *tail = blk;
+        done = n;
+    }
+
+    while (done < count) {
+        int n = count - done;
+        if (n > ARCHIVE_BLOCK_ROWS) n = ARCHIVE_BLOCK_ROWS;
+
+        struct SalesBlock blk;
+        if (!encodeBlock(&blk, NULL, rows + done, n)) {
+            fprintf(stderr, "Sales archive: out of memory\n");
+            break;
+        }
+        if (!appendBlock(&blk)) {
+            free(blk.data);
+            free(blk.dict);
+            fprintf(stderr, "Sales archive: out of memory\n");
+            break;
+        }
+        done += n;
+    }
+    return done;
+}
+
+// Calls visit() for every archived sale with fromDay <= day <= toDay and, if
+// productId >= 0, matching that product. Blocks whose min/max cannot match are
+// skipped without decoding. Returns the number of rows visited.
+long scanSalesArchive(int fromDay, int toDay, int productId,
+                      void (*visit)(const struct SalesRecord*, void*), void *ctx) {
+    struct SalesArchive *arc = &activeWarehouse->archive;
+    static _Thread_local long long col[SALES_ARCHIVE_COLUMNS][ARCHIVE_BLOCK_ROWS];
+    long visited = 0;
+    int lastDay = -1;
+    char lastDate[20] = "";
+
+    for (int b = 0; b < arc->blockCount; b++) {
+        const struct SalesBlock *blk = &arc->blocks[b];
+        if (blk->maxDay < fromDay || blk->minDay > toDay)
+            continue;
+        if (productId >= 0 && (productId < blk->minProduct || productId > blk->maxProduct))
+            continue;
+
+        // Filter columns only need decoding when the block is not entirely inside the range
+        int needDay = blk->minDay < fromDay || blk->maxDay > toDay;
+        int needProduct = productId >= 0 && (blk->minProduct != productId || blk->maxProduct != productId);
+        if (needDay || visit != NULL) decodeColumn(blk, COL_DAY, col[COL_DAY]);
+        if (needProduct || visit != NULL) decodeColumn(blk, COL_PRODUCT, col[COL_PRODUCT]);
+        if (visit != NULL) {
+            decodeColumn(blk, COL_QUANTITY, col[COL_QUANTITY]);
+            decodeColumn(blk, COL_CENTS, col[COL_CENTS]);
+            decodeColumn(blk, COL_NAME, col[COL_NAME]);
+        }
+
+        for (int i = 0; i < blk->rowCount; i++) {
+            if (needDay && (col[COL_DAY][i] < fromDay || col[COL_DAY][i] > toDay))
+                continue;
+            if (needProduct && col[COL_PRODUCT][i] != productId)
+                continue;
+            visited++;
+            if (visit == NULL)
+                continue;
+
+            struct SalesRecord rec;
+            rec.productId = (int)col[COL_PRODUCT][i];
+            rec.productName = blk->dict[col[COL_NAME][i]];
+            rec.quantitySold = (int)col[COL_QUANTITY][i];
+            rec.totalAmount = (float)col[COL_CENTS][i] / 100.0f;
+            // Rows are mostly in date order, so reformat only when the day changes
+            if (col[COL_DAY][i] != lastDay) {
+                lastDay = (int)col[COL_DAY][i];
+                formatSalesDate(lastDay, lastDate);
+            }
+            memcpy(rec.date, lastDate, sizeof(rec.date));
+            visit(&rec, ctx);
+        }
+    }
+    return visited;
+}
+
+// Total revenue of all archived sales
+float archivedRevenue() {
+    struct SalesArchive *arc = &activeWarehouse->archive;
+    return (float)arc->cents / 100.0f;
+}
+
+// Number of archived sales
+long archivedSalesCount() {
+    struct SalesArchive *arc = &activeWarehouse->archive;
+    return arc->rows;
+}
+
+// ---------------------- PERSISTENCE ----------------------
+
+static int writeInt(FILE *f, long long v) {
+    return fwrite(&v, sizeof(v), 1, f) == 1;
+}
+
+static int readInt(FILE *f, long long *v) {
+    return fread(v, sizeof(*v), 1, f) == 1;
+}
+
+// Writes the archive header and all sealed blocks to an open stream. StrId
+// handles are process-local, so each block's name dictionary is written out
+// as text.
+int writeSalesArchive(FILE *f) {
+    struct SalesArchive *arc = &activeWarehouse->archive;
+    int ok = fwrite(ARCHIVE_MAGIC, 4, 1, f) == 1
+          && writeInt(f, ARCHIVE_VERSION)
+          && writeInt(f, arc->blockCount);
+    for (int b = 0; b < arc->blockCount && ok; b++) {
+        const struct SalesBlock *blk = &arc->blocks[b];
+        ok = writeInt(f, blk->rowCount) && writeInt(f, blk->minDay) && writeInt(f, blk->maxDay)
+          && writeInt(f, blk->minProduct) && writeInt(f, blk->maxProduct)
+          && writeInt(f, blk->totalCents) && writeInt(f, blk->dictCount);
+        for (int c = 0; c <= SALES_ARCHIVE_COLUMNS && ok; c++)
+            ok = writeInt(f, (long long)blk->colOffset[c]);
+        for (int d = 0; d < blk->dictCount && ok; d++) {
+            const char *s = stringOf(blk->dict[d]);
+            long long len = (long long)strlen(s);
+            ok = writeInt(f, len) && fwrite(s, 1, (size_t)len, f) == (size_t)len;
+        }
+        size_t bytes = blk->colOffset[SALES_ARCHIVE_COLUMNS];
+        if (ok && bytes > 0)
+            ok = fwrite(blk->data, 1, bytes, f) == bytes;
+    }
+    return ok;
+}
+
+// Writes every warehouse's name, preference and archive section
+static int writeSiteArchives(FILE *f) {
+    struct Warehouse *prev = activeWarehouse;
+    int ok = fwrite(ARCHIVE_MAGIC, 4, 1, f) == 1
+          && writeInt(f, ARCHIVE_SITES_VERSION)
+          && writeInt(f, warehouseCount());
+    for (int i = 0; i < warehouseCount() && ok; i++) {
+        struct Warehouse *w = findWarehouse(i);
+        const char *name = stringOf(w->name);
+        long long len = (long long)strlen(name);
+        ok = writeInt(f, len) && fwrite(name, 1, (size_t)len, f) == (size_t)len
+          && writeInt(f, w->preference);
+        selectWarehouse(w);
+        ok = ok && writeSalesArchive(f);
+    }
+    selectWarehouse(prev);
+    return ok;
+}
+
+// Writes the sealed blocks of every warehouse to path. The archive is written
+// to path.tmp and then renamed over path, so a failed or interrupted save
+// leaves the previous archive intact.
+int saveSalesArchive(const char *path) {
+    size_t len = strlen(path);
+    char *tmp = (char*)malloc(len + 5);
+    if (tmp == NULL) {
+        printf("Not enough memory to save sales archive %s.\n", path);
+        return 0;
+    }
+    memcpy(tmp, path, len);
+    memcpy(tmp + len, ".tmp", 5);
+
+    FILE *f = fopen(tmp, "wb");
+    if (f == NULL) {
+        printf("Unable to open %s for writing.\n", tmp);
+        free(tmp);
+        return 0;
+    }
+
+    int ok = writeSiteArchives(f);
+    if (fclose(f) != 0) ok = 0;
+#ifdef _WIN32
+    ok = ok && MoveFileExA(tmp, path, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    ok = ok && rename(tmp, path) == 0;
+#endif
+    if (!ok) {
+        printf("Error while writing sales archive %s; the previous file is unchanged.\n", path);
+        remove(tmp);
+    }
+    free(tmp);
+    return ok;
+}
+
+// Reads an archive header and its blocks from an open stream and appends
+// them to the in-memory archive. name is only used in error messages.
+int readSalesArchive(FILE *f, const char *name) {
+    struct SalesArchive *arc = &activeWarehouse->archive;
+    char magic[4];
+    long long version, count;
+    if (fread(magic, 4, 1, f) != 1 || memcmp(magic, ARCHIVE_MAGIC, 4) != 0
+        || !readInt(f, &version) || version != ARCHIVE_VERSION || !readInt(f, &count)) {
+        printf("%s is not a sales archive.\n", name);
+        return 0;
+    }
+
+    int ok = 1;
+    char text[256];
+    for (long long b = 0; b < count && ok; b++) {
+        struct SalesBlock blk;
+        long long v[7], off;
+        memset(&blk, 0, sizeof(blk));
+        for (int i = 0; i < 7 && ok; i++)
+            ok = readInt(f, &v[i]);
+        if (!ok || v[0] <= 0 || v[0] > ARCHIVE_BLOCK_ROWS || v[6] < 0 || v[6] > v[0]) {
+            ok = 0;
+            break;
+        }
+        blk.rowCount = (int)v[0];
+        blk.minDay = (int)v[1];
+        blk.maxDay = (int)v[2];
+        blk.minProduct = (int)v[3];
+        blk.maxProduct = (int)v[4];
+        blk.totalCents = v[5];
+        blk.dictCount = (int)v[6];
+        // Offsets start at 0 and increase (every column holds at least one
+        // byte per row), and no row needs more than 10 bytes per column
+        for (int c = 0; c <= SALES_ARCHIVE_COLUMNS && ok; c++) {
+            ok = readInt(f, &off) && off >= 0 && off <= 10LL * SALES_ARCHIVE_COLUMNS * blk.rowCount
+              && (c == 0 ? off == 0 : off >= (long long)blk.colOffset[c - 1] + blk.rowCount);
+            blk.colOffset[c] = (size_t)off;
+        }
+
+        blk.dict = (StrId*)malloc(sizeof(StrId) * (blk.dictCount ? blk.dictCount : 1));
+        ok = ok && blk.dict != NULL;
+        for (int d = 0; d < blk.dictCount && ok; d++) {
+            long long len;
+            ok = readInt(f, &len) && len >= 0 && len < (long long)sizeof(text)
+              && fread(text, 1, (size_t)len, f) == (size_t)len;
+            if (ok) {
+                text[len] = '\0';
+                blk.dict[d] = internString(text);
+            }
+        }
+
+        size_t bytes = blk.colOffset[SALES_ARCHIVE_COLUMNS];
+        blk.data = ok ? (unsigned char*)malloc(bytes ? bytes : 1) : NULL;
+        ok = blk.data != NULL && (bytes == 0 || fread(blk.data, 1, bytes, f) == bytes)
+          && validateBlock(&blk) && appendBlock(&blk);
+        if (!ok) {
+            free(blk.data);
+            free(blk.dict);
+        }
+    }
+
+    if (!ok)
+        printf("Sales archive %s is truncated or corrupt; loaded %d blocks.\n", name, arc->blockCount);
+    return ok;
+}
+
+// Reads the site sections of an archive file. Each section is appended to
+// the first warehouse of the same name that has not received one yet, and
+// sites missing from this run are created. A version 1 file is appended to
+// the active warehouse.
+static int readSiteArchives(FILE *f, const char *name) {
+    char magic[4], text[256];
+    long long version, count;
+    if (fread(magic, 4, 1, f) != 1 || memcmp(magic, ARCHIVE_MAGIC, 4) != 0 || !readInt(f, &version)) {
+        printf("%s is not a sales archive.\n", name);
+        return 0;
+    }
+    if (version == ARCHIVE_VERSION) {
+        rewind(f);
+        return readSalesArchive(f, name);
+    }
+    if (version != ARCHIVE_SITES_VERSION || !readInt(f, &count) || count < 0 || count > MAX_WAREHOUSES) {
+        printf("%s is not a sales archive.\n", name);
+        return 0;
+    }
+
+    struct Warehouse *prev = activeWarehouse;
+    int filled[MAX_WAREHOUSES] = {0};
+    int ok = 1;
+    for (long long s = 0; s < count && ok; s++) {
+        long long len, preference;
+        ok = readInt(f, &len) && len > 0 && len < (long long)sizeof(text)
+          && fread(text, 1, (size_t)len, f) == (size_t)len
+          && readInt(f, &preference) && preference >= INT_MIN && preference <= INT_MAX;
+        if (!ok) {
+            printf("Sales archive %s is truncated or corrupt.\n", name);
+            break;
+        }
+        text[len] = '\0';
+
+        StrId siteName = internString(text);
+        struct Warehouse *w = NULL;
+        for (int i = 0; i < warehouseCount() && w == NULL; i++)
+            if (!filled[i] && findWarehouse(i)->name == siteName)
+                w = findWarehouse(i);
+        if (w == NULL)
+            w = createWarehouse(text, (int)preference);
+        ok = w != NULL;
+        if (ok) {
+            filled[w->id] = 1;
+            selectWarehouse(w);
+            ok = readSalesArchive(f, name);
+        }
+    }
+    selectWarehouse(prev);
+    return ok;
+}
+
+// Appends the blocks stored in path to the in-memory archives of the
+// warehouses. Returns 1 if the file was loaded or does not exist yet, 0 if it
+// exists but could not be read as a sales archive (it must then not be
+// overwritten).
+int loadSalesArchive(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        if (errno == ENOENT)
+            return 1;
+        printf("Unable to open sales archive %s.\n", path);
+        return 0;
+    }
+
+    int ok = readSiteArchives(f, path);
+    fclose(f);
+    return ok;
+}
+
+// ---------------------- REPORTS ----------------------
+
+struct ReportTotals {
+    int rows;
+    float revenue;
+};
+
+static void printArchivedSale(const struct SalesRecord *rec, void *ctx) {
+    struct ReportTotals *t = (struct ReportTotals*)ctx;
+    printf("Date: %s | Product: %-20s | Qty: %3d | Amount: $%7.2f\n",
+           rec->date, stringOf(rec->productName), rec->quantitySold, rec->totalAmount);
+    t->rows++;
+    t->revenue += rec->totalAmount;
+}
+
+// Prompts for a date range and optional product and lists matching archived sales
+void displayArchivedSalesReport() {
+    struct SalesArchive *arc = &activeWarehouse->archive;
+    char from[20], to[20];
+    if (arc->rows == 0) {
+        printf("No archived sales records.\n");
+        return;
+    }
+
+    printf("Enter start date (dd-mm-yyyy): ");
+    scanf(" %19s", from);
+    printf("Enter end date (dd-mm-yyyy): ");
+    scanf(" %19s", to);
+    int fromDay, toDay;
+    if (!parseSalesDate(from, &fromDay) || !parseSalesDate(to, &toDay)) {
+        printf("Invalid date format!\n");
+        return;
+    }
+
+    int productId = -1;
+    printf("Filter by product? (1=Yes, 0=No): ");
+    if (safeIntInput()) {
+        printf("Enter Product ID: ");
+        productId = safeIntInput();
+    }
+
+    struct ReportTotals totals = {0, 0.0f};
+    printf("\n=== ARCHIVED SALES REPORT ===\n");
+    scanSalesArchive(fromDay, toDay, productId, printArchivedSale, &totals);
+    printf("Total Sales: %d transactions | Total Revenue: $%.2f\n", totals.rows, totals.revenue);
+}
+
+static void sumArchivedSale(const struct SalesRecord *rec, void *ctx) {
+    *(double*)ctx += rec->totalAmount + rec->quantitySold + rec->productId;
+}
+
+// Prints compression ratio and full-scan throughput of the archive compared
+// with the same rows held as a raw SalesRecord array
+void displayArchiveStats() {
+    struct SalesArchive *arc = &activeWarehouse->archive;
+    printf("\n=== SALES ARCHIVE STATISTICS ===\n");
+    printf("Archived Sales: %ld in %d blocks\n", arc->rows, arc->blockCount);
+    if (arc->rows == 0) {
+        printf("================================\n");
+        return;
+    }
+
+    size_t encoded = 0;
+    for (int b = 0; b < arc->blockCount; b++)
+        encoded += sizeof(struct SalesBlock) + arc->blocks[b].colOffset[SALES_ARCHIVE_COLUMNS]
+                 + sizeof(StrId) * arc->blocks[b].dictCount;
+    size_t raw = sizeof(struct SalesRecord) * (size_t)arc->rows;
+    printf("Raw Size: %zu bytes | Archived Size: %zu bytes | Ratio: %.1fx\n",
+           raw, encoded, (double)raw / (double)encoded);
+
+    // Materialise the raw array to compare scanning it against decoding blocks
+    struct SalesRecord *rawRows = (struct SalesRecord*)malloc(raw);
+    if (rawRows == NULL) {
+        printf("Not enough memory to benchmark raw scan.\n");
+        printf("================================\n");
+        return;
+    }
+    long n = 0;
+    for (int b = 0; b < arc->blockCount; b++) {
+        static _Thread_local long long col[SALES_ARCHIVE_COLUMNS][ARCHIVE_BLOCK_ROWS];
+        for (int c = 0; c < SALES_ARCHIVE_COLUMNS; c++)
+            decodeColumn(&arc->blocks[b], c, col[c]);
+        for (int i = 0; i < arc->blocks[b].rowCount; i++, n++) {
+            rawRows[n].productId = (int)col[COL_PRODUCT][i];
+            rawRows[n].productName = arc->blocks[b].dict[col[COL_NAME][i]];
+            rawRows[n].quantitySold = (int)col[COL_QUANTITY][i];
+            rawRows[n].totalAmount = (float)col[COL_CENTS][i] / 100.0f;
+            formatSalesDate((int)col[COL_DAY][i], rawRows[n].date);
+        }
+    }
+
+    double sink = 0;
+    int passes = 0;
+    clock_t start = clock();
+    do {
+        for (long i = 0; i < n; i++)
+            sink += rawRows[i].totalAmount + rawRows[i].quantitySold + rawRows[i].productId;
+        passes++;
+    } while (clock() - start < CLOCKS_PER_SEC / 10);
+    double rawSecs = (double)(clock() - start) / CLOCKS_PER_SEC;
+    double rawRate = (double)n * passes / rawSecs;
+
+    passes = 0;
+    start = clock();
+    do {
+        scanSalesArchive(-2147483647, 2147483647, -1, sumArchivedSale, &sink);
+        passes++;
+    } while (clock() - start < CLOCKS_PER_SEC / 10);
+    double archSecs = (double)(clock() - start) / CLOCKS_PER_SEC;
+    double archRate = (double)n * passes / archSecs;
+
+    benchSink = sink;
+    printf("Raw Scan: %.1f M rows/s | Archive Scan: %.1f M rows/s\n",
+           rawRate / 1e6, archRate / 1e6);
+    printf("================================\n");
+    free(rawRows);
+}
@@ -0,0 +1,192 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "miniproj.h"
+
+// ---------------------- BEST SELLER RANKING ----------------------
+//
+// Per warehouse, one indexed binary max-heap per metric holds every product, keyed on its
+// cumulative units sold or revenue. Each product stores its own heap slot
+// (rankPos), so a sale only sifts that product up in O(log n), and the top K
+// are read off the heap in O(K log K) without sorting the catalog.
+
+// Returns 1 if a ranks above b for the metric (ties go to the lower ID)
+static int ranksAbove(const struct Product *a, const struct Product *b, int metric) {
+    if (metric == RANK_BY_UNITS) {
+        if (a->totalUnitsSold != b->totalUnitsSold)
+            return a->totalUnitsSold > b->totalUnitsSold;
+    } else {
+        if (a->totalRevenue != b->totalRevenue)
+            return a->totalRevenue > b->totalRevenue;
+    }
+    return a->id < b->id;
+}
+
+static void placeAt(struct SalesRanking *rk, int metric, int pos, struct Product *p) {
+    rk->heap[metric][pos] = p;
+    p->rankPos[metric] = pos;
+}
+
+static void siftUp(struct SalesRanking *rk, int metric, int pos) {
+    struct Product *p = rk->heap[metric][pos];
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (!ranksAbove(p, rk->heap[metric][parent], metric))
+            break;
+        placeAt(rk, metric, pos, rk->heap[metric][parent]);
+        pos = parent;
+    }
+    placeAt(rk, metric, pos, p);
+}
+
+static void siftDown(struct SalesRanking *rk, int metric, int pos) {
+    struct Product *p = rk->heap[metric][pos];
+    while (1) {
+        int child = 2 * pos + 1;
+        if (child >= rk->size)
+            break;
+        if (child + 1 < rk->size && ranksAbove(rk->heap[metric][child + 1], rk->heap[metric][child], metric))
+            child++;
+        if (!ranksAbove(rk->heap[metric][child], p, metric))
+            break;
+        placeAt(rk, metric, pos, rk->heap[metric][child]);
+        pos = child;
+    }
+    placeAt(rk, metric, pos, p);
+}
+
+// Adds a newly created product to the rankings
+void rankTrackProduct(struct Product *p) {
+    struct SalesRanking *rk = &activeWarehouse->ranking;
+    if (rk->size == rk->cap) {
+        int newCap = rk->cap ? rk->cap * 2 : 64;
+        for (int m = 0; m < RANK_METRICS; m++) {
+            struct Product **h = (struct Product**)realloc(rk->heap[m], sizeof(struct Product*) * newCap);
+            if (h == NULL) {
+                fprintf(stderr, "Sales ranking: out of memory\n");
+                p->rankPos[RANK_BY_UNITS] = p->rankPos[RANK_BY_REVENUE] = -1;
+                return;
+            }
+            rk->heap[m] = h;
+        }
+        rk->cap = newCap;
+    }
+
+    rk->size++;
+    for (int m = 0; m < RANK_METRICS; m++) {
+        placeAt(rk, m, rk->size - 1, p);
+        siftUp(rk, m, rk->size - 1);
+    }
+}
+
+// Removes a product from the rankings before it is freed
+void rankUntrackProduct(struct Product *p) {
+    struct SalesRanking *rk = &activeWarehouse->ranking;
+    if (p->rankPos[RANK_BY_UNITS] < 0)
+        return;
+
+    rk->size--;
+    for (int m = 0; m < RANK_METRICS; m++) {
+        int pos = p->rankPos[m];
+        p->rankPos[m] = -1;
+        if (pos == rk->size)
+            continue;
+        struct Product *moved = rk->heap[m][rk->size];
+        placeAt(rk, m, pos, moved);
+        siftUp(rk, m, pos);
+        siftDown(rk, m, moved->rankPos[m]);
+    }
+}
+
+// Transfers the heap slots of `from` to `to` (used when a BST node takes over
+// another node's data on deletion). `from` is left untracked.
+void rankMoveProduct(struct Product *from, struct Product *to) {
+    struct SalesRanking *rk = &activeWarehouse->ranking;
+    for (int m = 0; m < RANK_METRICS; m++) {
+        to->rankPos[m] = from->rankPos[m];
+        if (to->rankPos[m] >= 0)
+            rk->heap[m][to->rankPos[m]] = to;
+        from->rankPos[m] = -1;
+    }
+}
+
+// Adds a sale to a product's cumulative counters and restores heap order
+void rankRecordSale(struct Product *p, int units, float revenue) {
+    struct SalesRanking *rk = &activeWarehouse->ranking;
+    p->totalUnitsSold += units;
+    p->totalRevenue += revenue;
+    if (p->rankPos[RANK_BY_UNITS] < 0)
+        return;
+    for (int m = 0; m < RANK_METRICS; m++)
+        siftUp(rk, m, p->rankPos[m]);
+}
+
+// Fills out[] with up to k best products for the metric, best first, and
+// returns how many were written. Walks the heap with a small frontier heap of
+// candidate slots, so the cost is O(k log k) regardless of catalog size.
+int topSellers(int metric, int k, struct Product **out) {
+    struct SalesRanking *rk = &activeWarehouse->ranking;
+    if (k > rk->size) k = rk->size;
+    if (k <= 0) return 0;
+
+    int *frontier = (int*)malloc(sizeof(int) * (k + 1));
+    if (frontier == NULL) {
+        fprintf(stderr, "Sales ranking: out of memory\n");
+        return 0;
+    }
+
+    struct Product **heap = rk->heap[metric];
+    int fsize = 1, n = 0;
+    frontier[0] = 0;
+    while (n < k) {
+        int best = frontier[0];
+        out[n++] = heap[best];
+
+        // Pop the best slot, then push its children
+        frontier[0] = frontier[--fsize];
+        for (int pos = 0;;) {
+            int c = 2 * pos + 1;
+            if (c >= fsize) break;
+            if (c + 1 < fsize && ranksAbove(heap[frontier[c + 1]], heap[frontier[c]], metric)) c++;
+            if (!ranksAbove(heap[frontier[c]], heap[frontier[pos]], metric)) break;
+            int t = frontier[c]; frontier[c] = frontier[pos]; frontier[pos] = t;
+            pos = c;
+        }
+        for (int child = 2 * best + 1; child <= 2 * best + 2 && child < rk->size; child++) {
+            if (fsize > k) break;
+            int pos = fsize++;
+            frontier[pos] = child;
+            while (pos > 0 && ranksAbove(heap[frontier[pos]], heap[frontier[(pos - 1) / 2]], metric)) {
+                int t = frontier[pos]; frontier[pos] = frontier[(pos - 1) / 2]; frontier[(pos - 1) / 2] = t;
+                pos = (pos - 1) / 2;
+            }
+        }
+    }
+
+    free(frontier);
+    return n;
+}
+
+// Prints the top k products by units sold and by revenue
+void displayTopSellers(int k) {
+    struct Product **top = (struct Product**)malloc(sizeof(struct Product*) * (k > 0 ? k : 1));
+    if (top == NULL) {
+        printf("Not enough memory for top sellers report.\n");
+        return;
+    }
+
+    int n = topSellers(RANK_BY_UNITS, k, top);
+    printf("\n--- Top %d by Units Sold ---\n", k);
+    if (n == 0) printf("No products in inventory.\n");
+    for (int i = 0; i < n; i++)
+        printf("%2d. ID: %4d | Name: %-20s | Units: %6lld | Revenue: $%10.2f\n",
+               i + 1, top[i]->id, stringOf(top[i]->name), top[i]->totalUnitsSold, top[i]->totalRevenue);
+
+    n = topSellers(RANK_BY_REVENUE, k, top);
+    printf("\n--- Top %d by Revenue ---\n", k);
+    if (n == 0) printf("No products in inventory.\n");
+    for (int i = 0; i < n; i++)
+        printf("%2d. ID: %4d | Name: %-20s | Units: %6lld | Revenue: $%10.2f\n",
+               i + 1, top[i]->id, stringOf(top[i]->name), top[i]->totalUnitsSold, top[i]->totalRevenue);
+
+    free(top);
+}
@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "miniproj.h"
+
+// ---------------------- STRING POOL (INTERNER) ----------------------
+//
+// Names, suppliers and customer names repeat heavily across products, orders
+// and sales records, so each distinct string is stored exactly once and the
+// records keep a 32-bit StrId instead of an inline char[50].
+// Handle 0 is always the empty string, so zero-initialised records are valid.
+
+static char *poolChars = NULL;          // Arena holding every interned string back to back
+static size_t poolCharsUsed = 0;        // Bytes used in the arena
+static size_t poolCharsCap = 0;         // Bytes allocated for the arena
+
+static unsigned int *poolOffsets = NULL; // StrId -> offset into poolChars
+static unsigned int poolCount = 0;       // Number of interned strings
+static unsigned int poolOffsetsCap = 0;
+
+static StrId *poolSlots = NULL;          // Open-addressing hash table (StrId + 1, 0 = empty)
+static unsigned int poolSlotCap = 0;     // Always a power of two
+
+// FNV-1a hash of a NUL-terminated string
+static unsigned int hashString(const char *s) {
+    unsigned int h = 2166136261u;
+    while (*s) {
+        h ^= (unsigned char)*s++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// Rebuilds the hash table with twice the slots
+static int growSlots() {
+    unsigned int newCap = poolSlotCap ? poolSlotCap * 2 : 256;
+    StrId *newSlots = (StrId*)calloc(newCap, sizeof(StrId));
+    if (newSlots == NULL)
+        return 0;
+
+    for (unsigned int i = 0; i < poolSlotCap; i++) {
+        if (poolSlots[i] == 0) continue;
+        unsigned int j = hashString(poolChars + poolOffsets[poolSlots[i] - 1]) & (newCap - 1);
+        while (newSlots[j] != 0)
+            j = (j + 1) & (newCap - 1);
+        newSlots[j] = poolSlots[i];
+    }
+
+    free(poolSlots);
+    poolSlots = newSlots;
+    poolSlotCap = newCap;
+    return 1;
+}
+
+// Appends a string to the arena and returns its new handle
+static int appendString(const char *s, size_t len, StrId *out) {
+    if (poolCharsUsed + len + 1 > poolCharsCap) {
+        size_t newCap = poolCharsCap ? poolCharsCap * 2 : 4096;
+        while (newCap < poolCharsUsed + len + 1)
+            newCap *= 2;
+        char *newChars = (char*)realloc(poolChars, newCap);
+        if (newChars == NULL)
+            return 0;
+        poolChars = newChars;
+        poolCharsCap = newCap;
+    }
+    if (poolCount == poolOffsetsCap) {
+        unsigned int newCap = poolOffsetsCap ? poolOffsetsCap * 2 : 256;
+        unsigned int *newOffsets = (unsigned int*)realloc(poolOffsets, newCap * sizeof(unsigned int));
+        if (newOffsets == NULL)
+            return 0;
+        poolOffsets = newOffsets;
+        poolOffsetsCap = newCap;
+    }
+
+    memcpy(poolChars + poolCharsUsed, s, len + 1);
+    poolOffsets[poolCount] = (unsigned int)poolCharsUsed;
+    poolCharsUsed += len + 1;
+    *out = poolCount++;
+    return 1;
+}
+
+// Returns the handle for a string, adding it to the pool on first use
+StrId internString(const char *s) {
+    if (s == NULL || *s == '\0')
+        return 0;
+
+    // Handle 0 is reserved for the empty string
+    if (poolCount == 0) {
+        StrId empty;
+        if (!appendString("", 0, &empty)) {
+            fprintf(stderr, "String pool: out of memory\n");
+            return 0;
+        }
+    }
+
+    // Keep the load factor under 3/4
+    if ((poolCount + 1) * 4 >= poolSlotCap * 3 && !growSlots()) {
+        fprintf(stderr, "String pool: out of memory\n");
+        return 0;
+    }
+
+    unsigned int i = hashString(s) & (poolSlotCap - 1);
+    while (poolSlots[i] != 0) {
+        StrId id = poolSlots[i] - 1;
+        if (strcmp(poolChars + poolOffsets[id], s) == 0)
+            return id;
+        i = (i + 1) & (poolSlotCap - 1);
+    }
+
+    StrId id;
+    if (!appendString(s, strlen(s), &id)) {
+        fprintf(stderr, "String pool: out of memory\n");
+        return 0;
+    }
+    poolSlots[i] = id + 1;
+    return id;
+}
+
+// Returns the text for a handle. The pointer is only valid until the next
+// internString call, so copy it if it must outlive that.
+const char* stringOf(StrId id) {
+    if (id >= poolCount)
+        return "";
+    return poolChars + poolOffsets[id];
+}
+
+// Number of distinct strings currently interned
+unsigned int internedStringCount() {
+    return poolCount;
+}
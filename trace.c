@@ -0,0 +1,667 @@
+// clock_gettime and nanosleep are POSIX, not ISO C
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include "miniproj.h"
+
+// ---------------------- OPERATION TRACE ----------------------
+//
+// While recording, every call into the core inventory functions is appended
+// to a binary trace. Each record is:
+//   op (1 byte) | microseconds since previous record (varint) |
+//   warehouse ID (varint) | op arguments
+// Integers are varints (zigzag for signed values), prices are raw 4-byte
+// floats and strings are a varint length followed by the bytes. Starting a
+// trace first writes a snapshot of the current state of every warehouse:
+// its sealed sales archive (in the archive file format), products with their
+// sales counters, pending orders and in-memory sales history, closed by a
+// TRACE_SNAPSHOT_END record. A replay thus starts from the same state, and
+// only the records after the marker are counted and timed. The header also
+// stores the runtime configuration the recording ran with.
+
+#define TRACE_MAGIC "WHTR"
+#define TRACE_VERSION 2
+
+enum {
+    TRACE_CREATE_WAREHOUSE = 1,
+    TRACE_INSERT_PRODUCT,
+    TRACE_DELETE_PRODUCT,
+    TRACE_INSERT_ORDER,
+    TRACE_DELETE_MAX,
+    TRACE_DISPATCH,
+    TRACE_RESTOCK,
+    TRACE_SET_PRICE,
+    TRACE_UPDATE_PRODUCT,
+    TRACE_CLEAR_ORDERS,
+    TRACE_ARCHIVE_SALES,
+    TRACE_PRODUCT_SALES,        // Snapshot only: sales counters of a product
+    TRACE_ADD_SALE,             // Snapshot only: an in-memory sales record
+    TRACE_LOAD_ARCHIVE,         // Snapshot only: a site's sealed archive blocks
+    TRACE_SNAPSHOT_END          // Snapshot only: the recorded operations follow
+};
+
+static FILE *traceFile = NULL;
+static long long traceLastMicros = 0;
+static long traceOps = 0;
+static pthread_mutex_t traceLock = PTHREAD_MUTEX_INITIALIZER;
+
+// Monotonic wall clock in nanoseconds
+long long nowNanos() {
+#ifdef _WIN32
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (long long)(now.QuadPart * 1e9 / freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+#endif
+}
+
+static long long nowMicros() {
+    return nowNanos() / 1000;
+}
+
+static void sleepMicros(long long us) {
+    if (us <= 0) return;
+#ifdef _WIN32
+    Sleep((DWORD)(us / 1000));
+#else
+    struct timespec ts;
+    ts.tv_sec = us / 1000000;
+    ts.tv_nsec = (us % 1000000) * 1000;
+    nanosleep(&ts, NULL);
+#endif
+}
+
+// ---------------------- ENCODING ----------------------
+
+static void writeVarint(unsigned long long v) {
+    while (v >= 0x80) {
+        putc((int)(v | 0x80) & 0xff, traceFile);
+        v >>= 7;
+    }
+    putc((int)v, traceFile);
+}
+
+static void writeSigned(long long v) {
+    writeVarint(((unsigned long long)v << 1) ^ (unsigned long long)(v >> 63));
+}
+
+static void writeString(const char *s) {
+    size_t len = strlen(s);
+    writeVarint(len);
+    fwrite(s, 1, len, traceFile);
+}
+
+static void writeFloat(float f) {
+    fwrite(&f, sizeof(f), 1, traceFile);
+}
+
+static void writeDouble(double d) {
+    fwrite(&d, sizeof(d), 1, traceFile);
+}
+
+static int readVarint(FILE *f, unsigned long long *v) {
+    int c, shift = 0;
+    *v = 0;
+    do {
+        if ((c = getc(f)) == EOF || shift > 63) return 0;
+        *v |= (unsigned long long)(c & 0x7f) << shift;
+        shift += 7;
+    } while (c & 0x80);
+    return 1;
+}
+
+static int readSigned(FILE *f, long long *v) {
+    unsigned long long u;
+    if (!readVarint(f, &u)) return 0;
+    *v = (long long)(u >> 1) ^ -(long long)(u & 1);
+    return 1;
+}
+
+static int readString(FILE *f, char *buf, size_t size) {
+    unsigned long long len;
+    if (!readVarint(f, &len) || len >= size) return 0;
+    if (fread(buf, 1, (size_t)len, f) != (size_t)len) return 0;
+    buf[len] = '\0';
+    return 1;
+}
+
+// Starts a record; the caller holds traceLock and writes the arguments
+static void beginRecord(int op) {
+    long long now = nowMicros();
+    putc(op, traceFile);
+    writeVarint((unsigned long long)(now - traceLastMicros));
+    writeVarint(activeWarehouse ? (unsigned long long)activeWarehouse->id : 0);
+    traceLastMicros = now;
+    traceOps++;
+}
+
+// ---------------------- RECORDING HOOKS ----------------------
+
+int traceActive() {
+    return traceFile != NULL;
+}
+
+void traceCreateWarehouse(const char *name, int preference) {
+    if (traceFile == NULL) return;
+    pthread_mutex_lock(&traceLock);
+    beginRecord(TRACE_CREATE_WAREHOUSE);
+    writeString(name);
+    writeSigned(preference);
+    pthread_mutex_unlock(&traceLock);
+}
+
+void traceInsertProduct(int id, const char *name, int stock, float price, const char *supplier) {
+    if (traceFile == NULL) return;
+    pthread_mutex_lock(&traceLock);
+    beginRecord(TRACE_INSERT_PRODUCT);
+    writeSigned(id);
+    writeString(name);
+    writeSigned(stock);
+    writeFloat(price);
+    writeString(supplier);
+    pthread_mutex_unlock(&traceLock);
+}
+
+void traceDeleteProduct(int id) {
+    if (traceFile == NULL) return;
+    pthread_mutex_lock(&traceLock);
+    beginRecord(TRACE_DELETE_PRODUCT);
+    writeSigned(id);
+    pthread_mutex_unlock(&traceLock);
+}
+
+void traceInsertOrder(int id, int quantity, int priority, const char *customerName) {
+    if (traceFile == NULL) return;
+    pthread_mutex_lock(&traceLock);
+    beginRecord(TRACE_INSERT_ORDER);
+    writeSigned(id);
+    writeSigned(quantity);
+    writeSigned(priority);
+    writeString(customerName);
+    pthread_mutex_unlock(&traceLock);
+}
+
+void traceDeleteMax() {
+    if (traceFile == NULL) return;
+    pthread_mutex_lock(&traceLock);
+    beginRecord(TRACE_DELETE_MAX);
+    pthread_mutex_unlock(&traceLock);
+}
+
+void traceDispatch(int id, int quantity) {
+    if (traceFile == NULL) return;
+    pthread_mutex_lock(&traceLock);
+    beginRecord(TRACE_DISPATCH);
+    writeSigned(id);
+    writeSigned(quantity);
+    pthread_mutex_unlock(&traceLock);
+}
+
+void traceRestock(int id, int quantity) {
+    if (traceFile == NULL) return;
+    pthread_mutex_lock(&traceLock);
+    beginRecord(TRACE_RESTOCK);
+    writeSigned(id);
+    writeSigned(quantity);
+    pthread_mutex_unlock(&traceLock);
+}
+
+void traceSetPrice(int id, float price) {
+    if (traceFile == NULL) return;
+    pthread_mutex_lock(&traceLock);
+    beginRecord(TRACE_SET_PRICE);
+    writeSigned(id);
+    writeFloat(price);
+    pthread_mutex_unlock(&traceLock);
+}
+
+void traceUpdateProduct(int id, const char *name, int stock, float price, const char *supplier) {
+    if (traceFile == NULL) return;
+    pthread_mutex_lock(&traceLock);
+    beginRecord(TRACE_UPDATE_PRODUCT);
+    writeSigned(id);
+    writeString(name);
+    writeSigned(stock);
+    writeFloat(price);
+    writeString(supplier);
+    pthread_mutex_unlock(&traceLock);
+}
+
+void traceClearOrders() {
+    if (traceFile == NULL) return;
+    pthread_mutex_lock(&traceLock);
+    beginRecord(TRACE_CLEAR_ORDERS);
+    pthread_mutex_unlock(&traceLock);
+}
+
+void traceArchiveSales() {
+    if (traceFile == NULL) return;
+    pthread_mutex_lock(&traceLock);
+    beginRecord(TRACE_ARCHIVE_SALES);
+    pthread_mutex_unlock(&traceLock);
+}
+
+// Records a product tree in pre-order, so replaying the inserts rebuilds the
+// same shape instead of a sorted (degenerate) chain
+static void snapshotProducts(struct Product *root) {
+    struct Product **stack = NULL;
+    int top = 0, cap = 0;
+
+    if (root != NULL) {
+        stack = (struct Product**)malloc(sizeof(struct Product*) * 64);
+        if (stack == NULL) {
+            fprintf(stderr, "Trace: out of memory while writing snapshot\n");
+            return;
+        }
+        cap = 64;
+        stack[top++] = root;
+    }
+    while (top > 0) {
+        struct Product *p = stack[--top];
+        beginRecord(TRACE_INSERT_PRODUCT);
+        writeSigned(p->id);
+        writeString(stringOf(p->name));
+        writeSigned(p->stock);
+        writeFloat(p->price);
+        writeString(stringOf(p->supplier));
+        if (p->lastSaleDay >= 0 || p->totalUnitsSold != 0) {
+            beginRecord(TRACE_PRODUCT_SALES);
+            writeSigned(p->id);
+            writeSigned(p->totalUnitsSold);
+            writeDouble(p->totalRevenue);
+            writeFloat(p->velocity);
+            writeFloat(p->velocityVar);
+            writeSigned(p->unitsToday);
+            writeSigned(p->lastSaleDay);
+        }
+
+        if (top + 2 > cap) {
+            struct Product **grown = (struct Product**)realloc(stack, sizeof(struct Product*) * cap * 2);
+            if (grown == NULL) {
+                fprintf(stderr, "Trace: out of memory while writing snapshot\n");
+                break;
+            }
+            stack = grown;
+            cap *= 2;
+        }
+        if (p->right) stack[top++] = p->right;
+        if (p->left) stack[top++] = p->left;
+    }
+    free(stack);
+}
+
+// Opens a trace file and writes a snapshot of the current state into it
+int traceStart(const char *path) {
+    if (traceFile != NULL) {
+        printf("A trace is already being recorded.\n");
+        return 0;
+    }
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        printf("Unable to open %s for writing.\n", path);
+        return 0;
+    }
+    fwrite(TRACE_MAGIC, 4, 1, f);
+    putc(TRACE_VERSION, f);
+
+    pthread_mutex_lock(&traceLock);
+    traceFile = f;
+    writeVarint((unsigned long long)LOW_STOCK_THRESHOLD);
+    writeVarint((unsigned long long)MAX_HISTORY);
+    writeVarint((unsigned long long)REORDER_LEAD_DAYS);
+    traceLastMicros = nowMicros();
+
+    struct Warehouse *prev = activeWarehouse;
+    for (int i = 0; i < warehouseCount(); i++) {
+        struct Warehouse *w = findWarehouse(i);
+        activeWarehouse = w;
+
+        beginRecord(TRACE_CREATE_WAREHOUSE);
+        writeString(stringOf(w->name));
+        writeSigned(w->preference);
+
+        if (w->archive.blockCount > 0) {
+            beginRecord(TRACE_LOAD_ARCHIVE);
+            writeSalesArchive(traceFile);
+        }
+        snapshotProducts(w->root);
+        // Queue order is kept because equal priorities insert behind each other
+        for (struct Order *o = w->front; o != NULL; o = o->next) {
+            beginRecord(TRACE_INSERT_ORDER);
+            writeSigned(o->productId);
+            writeSigned(o->quantity);
+            writeSigned(o->priority);
+            writeString(stringOf(o->customerName));
+        }
+        for (int s = 0; s < w->salesCount; s++) {
+            const struct SalesRecord *r = &w->salesHistory[s];
+            beginRecord(TRACE_ADD_SALE);
+            writeSigned(r->productId);
+            writeString(stringOf(r->productName));
+            writeSigned(r->quantitySold);
+            writeFloat(r->totalAmount);
+            writeString(r->date);
+        }
+    }
+    activeWarehouse = prev;
+    beginRecord(TRACE_SNAPSHOT_END);
+    traceOps = 0;
+    pthread_mutex_unlock(&traceLock);
+    return 1;
+}
+
+// Stops recording; returns the number of operations written
+long traceStop() {
+    if (traceFile == NULL)
+        return 0;
+    pthread_mutex_lock(&traceLock);
+    fclose(traceFile);
+    traceFile = NULL;
+    pthread_mutex_unlock(&traceLock);
+    return traceOps;
+}
+
+// ---------------------- STATE CHECKSUM ----------------------
+
+static void hashBytes(unsigned long long *h, const void *data, size_t len) {
+    const unsigned char *p = (const unsigned char*)data;
+    for (size_t i = 0; i < len; i++) {
+        *h ^= p[i];
+        *h *= 1099511628211ULL;
+    }
+}
+
+static void hashInt(unsigned long long *h, long long v) {
+    hashBytes(h, &v, sizeof(v));
+}
+
+static void hashString(unsigned long long *h, StrId s) {
+    const char *text = stringOf(s);
+    hashBytes(h, text, strlen(text) + 1);
+}
+
+// FNV-1a hash over every warehouse's products (with their sales totals),
+// pending orders, sales history and archive totals. Sale dates, velocities and
+// the low stock flag (which follows the velocity) are left out so replays on
+// another day still match.
+unsigned long long stateChecksum() {
+    unsigned long long h = 1469598103934665603ULL;
+    struct ProductCursor c;
+    cursorInit(&c);
+    for (int i = 0; i < warehouseCount(); i++) {
+        struct Warehouse *w = findWarehouse(i);
+        hashString(&h, w->name);
+        for (struct Product *p = cursorFirst(&c, w->root); p != NULL; p = cursorNext(&c)) {
+            hashInt(&h, p->id);
+            hashInt(&h, p->stock);
+            hashBytes(&h, &p->price, sizeof(p->price));
+            hashString(&h, p->name);
+            hashString(&h, p->supplier);
+            hashInt(&h, p->totalUnitsSold);
+            hashBytes(&h, &p->totalRevenue, sizeof(p->totalRevenue));
+        }
+        for (struct Order *o = w->front; o != NULL; o = o->next) {
+            hashInt(&h, o->productId);
+            hashInt(&h, o->quantity);
+            hashInt(&h, o->priority);
+            hashString(&h, o->customerName);
+        }
+        for (int s = 0; s < w->salesCount; s++) {
+            hashInt(&h, w->salesHistory[s].productId);
+            hashInt(&h, w->salesHistory[s].quantitySold);
+            hashBytes(&h, &w->salesHistory[s].totalAmount, sizeof(float));
+        }
+        hashInt(&h, w->archive.rows);
+        hashInt(&h, w->archive.cents);
+    }
+    cursorFree(&c);
+    return h;
+}
+
+// ---------------------- REPLAY DRIVER ----------------------
+
+static int compareLatency(const void *a, const void *b) {
+    long long x = *(const long long*)a, y = *(const long long*)b;
+    return (x > y) - (x < y);
+}
+
+static long long percentile(const long long *sorted, long n, double pct) {
+    long idx = (long)(pct / 100.0 * (n - 1) + 0.5);
+    return sorted[idx];
+}
+
+// Replays a trace into a fresh process state. The snapshot is restored first
+// without pacing or timing. With paced set, the recorded operations are then
+// issued at their recorded spacing; otherwise as fast as possible. Prints
+// throughput, latency percentiles and the final state checksum to stderr.
+// Returns 0 on success.
+int replayTrace(const char *path, int paced) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        fprintf(stderr, "Unable to open trace %s\n", path);
+        return 1;
+    }
+    char magic[4];
+    unsigned long long lowStock, maxHistory, leadDays;
+    if (fread(magic, 4, 1, f) != 1 || memcmp(magic, TRACE_MAGIC, 4) != 0 || getc(f) != TRACE_VERSION
+        || !readVarint(f, &lowStock) || !readVarint(f, &maxHistory) || !readVarint(f, &leadDays)) {
+        fprintf(stderr, "%s is not a trace file\n", path);
+        fclose(f);
+        return 1;
+    }
+    if (warehouseCount() != 0) {
+        fprintf(stderr, "Replay needs a fresh state with no warehouses\n");
+        fclose(f);
+        return 1;
+    }
+    initConfig((int)lowStock, (int)maxHistory, (int)leadDays);
+
+    long count = 0, cap = 1024;
+    long long *latency = (long long*)malloc(sizeof(long long) * cap);
+    if (latency == NULL) {
+        fprintf(stderr, "Replay: out of memory\n");
+        fclose(f);
+        return 1;
+    }
+    char name[256], other[256];
+    int op, ok = 1, inSnapshot = 1;
+    long snapshotRecords = 0;
+    long long start = nowMicros(), recorded = 0, restoreMicros = 0;
+
+    while (ok && (op = getc(f)) != EOF) {
+        unsigned long long delta, wid;
+        long long a = 0, b = 0, p = 0, q = 0;
+        float price = 0.0f, var = 0.0f;
+        double revenue = 0.0;
+
+        ok = readVarint(f, &delta) && readVarint(f, &wid);
+        if (!ok) break;
+
+        if (op == TRACE_SNAPSHOT_END) {
+            if (!inSnapshot) {
+                ok = 0;
+                break;
+            }
+            // Time the recorded operations from here on
+            inSnapshot = 0;
+            restoreMicros = nowMicros() - start;
+            start = nowMicros();
+            continue;
+        }
+
+        // Decode arguments before timing so only the core call is measured
+        switch (op) {
+            case TRACE_CREATE_WAREHOUSE:
+                ok = readString(f, name, sizeof(name)) && readSigned(f, &a);
+                break;
+            case TRACE_INSERT_PRODUCT:
+                ok = readSigned(f, &a) && readString(f, name, sizeof(name)) && readSigned(f, &b)
+                  && fread(&price, sizeof(price), 1, f) == 1 && readString(f, other, sizeof(other));
+                break;
+            case TRACE_INSERT_ORDER:
+                ok = readSigned(f, &a) && readSigned(f, &b) && readSigned(f, &p)
+                  && readString(f, name, sizeof(name));
+                break;
+            case TRACE_DISPATCH:
+            case TRACE_RESTOCK:
+                ok = readSigned(f, &a) && readSigned(f, &b);
+                break;
+            case TRACE_SET_PRICE:
+                ok = readSigned(f, &a) && fread(&price, sizeof(price), 1, f) == 1;
+                break;
+            case TRACE_UPDATE_PRODUCT:
+                ok = readSigned(f, &a) && readString(f, name, sizeof(name)) && readSigned(f, &b)
+                  && fread(&price, sizeof(price), 1, f) == 1 && readString(f, other, sizeof(other));
+                break;
+            case TRACE_PRODUCT_SALES:
+                ok = readSigned(f, &a) && readSigned(f, &b) && fread(&revenue, sizeof(revenue), 1, f) == 1
+                  && fread(&price, sizeof(price), 1, f) == 1 && fread(&var, sizeof(var), 1, f) == 1
+                  && readSigned(f, &p) && readSigned(f, &q);
+                break;
+            case TRACE_ADD_SALE:
+                ok = readSigned(f, &a) && readString(f, name, sizeof(name)) && readSigned(f, &b)
+                  && fread(&price, sizeof(price), 1, f) == 1 && readString(f, other, 20);
+                break;
+            case TRACE_DELETE_PRODUCT:
+                ok = readSigned(f, &a);
+                break;
+            case TRACE_DELETE_MAX:
+            case TRACE_CLEAR_ORDERS:
+            case TRACE_ARCHIVE_SALES:
+            case TRACE_LOAD_ARCHIVE:    // Read below, straight into the archive
+                break;
+            default:
+                ok = 0;
+        }
+        if (!ok) break;
+
+        struct Warehouse *w = NULL;
+        if (op != TRACE_CREATE_WAREHOUSE) {
+            w = findWarehouse((int)wid);
+            if (w == NULL) {
+                fprintf(stderr, "Trace references unknown warehouse %llu\n", wid);
+                ok = 0;
+                break;
+            }
+            selectWarehouse(w);
+        }
+
+        if (!inSnapshot) {
+            recorded += (long long)delta;
+            if (paced)
+                sleepMicros(start + recorded - nowMicros());
+        }
+
+        long long t0 = nowNanos();
+        switch (op) {
+            case TRACE_CREATE_WAREHOUSE:
+                createWarehouse(name, (int)a);
+                break;
+            case TRACE_INSERT_PRODUCT:
+                w->root = insertBST(w->root, (int)a, name, (int)b, price, other);
+                break;
+            case TRACE_DELETE_PRODUCT:
+                w->root = deleteProductBST(w->root, (int)a);
+                break;
+            case TRACE_INSERT_ORDER:
+                insertPQ((int)a, (int)b, (int)p, name);
+                break;
+            case TRACE_DELETE_MAX:
+                free(deleteMax());
+                break;
+            case TRACE_DISPATCH:
+                updateStockAfterDispatch((int)a, (int)b);
+                break;
+            case TRACE_RESTOCK:
+                applyRestock((int)a, (int)b);
+                break;
+            case TRACE_SET_PRICE: {
+                struct Product *sp = searchBST(w->root, (int)a);
+                if (sp) sp->price = price;
+                break;
+            }
+            case TRACE_UPDATE_PRODUCT:
+                applyProductUpdate((int)a, internString(name), (int)b, price, internString(other));
+                break;
+            case TRACE_CLEAR_ORDERS:
+                clearOrders();
+                break;
+            case TRACE_ARCHIVE_SALES:
+                archiveSalesHistory();
+                break;
+            case TRACE_PRODUCT_SALES: {
+                struct Product *sp = searchBST(w->root, (int)a);
+                if (sp) {
+                    sp->velocity = price;
+                    sp->velocityVar = var;
+                    sp->unitsToday = (int)p;
+                    sp->lastSaleDay = (int)q;
+                    sp->totalUnitsSold = b;
+                    sp->totalRevenue = revenue;
+                    sp->lowStockFlag = isLowStock(sp, todaySalesDay());
+                    rankRecordSale(sp, 0, 0.0f); // Restores heap order for the new totals
+                }
+                break;
+            }
+            case TRACE_ADD_SALE:
+                addSalesRecord((int)a, internString(name), (int)b, price, other);
+                break;
+            case TRACE_LOAD_ARCHIVE:
+                ok = readSalesArchive(f, path);
+                break;
+        }
+        long long t1 = nowNanos();
+        if (!ok) break;
+
+        if (inSnapshot) {
+            snapshotRecords++;
+            continue;
+        }
+        if (count == cap) {
+            long long *grown = (long long*)realloc(latency, sizeof(long long) * cap * 2);
+            if (grown == NULL) {
+                ok = 0;
+                break;
+            }
+            latency = grown;
+            cap *= 2;
+        }
+        latency[count++] = t1 - t0;
+    }
+    long long elapsed = nowMicros() - start;
+    fclose(f);
+
+    if (ok && inSnapshot) {
+        fprintf(stderr, "Trace %s ends inside its snapshot\n", path);
+        ok = 0;
+    } else if (!ok) {
+        fprintf(stderr, "Trace %s is truncated or corrupt after %ld operations\n", path, count);
+    }
+
+    fprintf(stderr, "\n=== REPLAY REPORT ===\n");
+    fprintf(stderr, "Mode: %s\n", paced ? "original pacing" : "as fast as possible");
+    fprintf(stderr, "Snapshot: %ld records restored in %.3f s\n", snapshotRecords,
+            (inSnapshot ? elapsed : restoreMicros) / 1e6);
+    fprintf(stderr, "Operations: %ld in %.3f s (recorded span %.3f s)\n",
+            count, elapsed / 1e6, recorded / 1e6);
+    if (count > 0) {
+        qsort(latency, count, sizeof(long long), compareLatency);
+        fprintf(stderr, "Throughput: %.0f ops/s\n", elapsed > 0 ? count * 1e6 / elapsed : 0.0);
+        fprintf(stderr, "Latency (ns): p50 %lld | p90 %lld | p99 %lld | max %lld\n",
+                percentile(latency, count, 50), percentile(latency, count, 90),
+                percentile(latency, count, 99), latency[count - 1]);
+    }
+    fprintf(stderr, "State Checksum: %016llx\n", stateChecksum());
+    free(latency);
+    return ok ? 0 : 1;
+}
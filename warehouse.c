@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "miniproj.h"
+
+// ---------------------- WAREHOUSE REGISTRY ----------------------
+//
+// Every site owns its product index, order queue, sales log, archive and
+// best seller heaps. The core functions work on activeWarehouse, which is
+// per thread so each dispatch worker can drain its own site concurrently.
+// Interning strings and changing the registry stay on the menu thread.
+
+static struct Warehouse *warehouses[MAX_WAREHOUSES];
+static int numWarehouses = 0;
+
+_Thread_local struct Warehouse *activeWarehouse = NULL;
+
+// Creates a new, empty warehouse. The first one created becomes active.
+struct Warehouse* createWarehouse(const char *name, int preference) {
+    if (numWarehouses == MAX_WAREHOUSES) {
+        printf("Cannot add more than %d warehouses.\n", MAX_WAREHOUSES);
+        return NULL;
+    }
+
+    traceCreateWarehouse(name, preference);
+    struct Warehouse *w = (struct Warehouse*)calloc(1, sizeof(struct Warehouse));
+    if (w == NULL) {
+        fprintf(stderr, "Failed to allocate warehouse %s\n", name);
+        return NULL;
+    }
+    w->id = numWarehouses;
+    w->name = internString(name);
+    w->preference = preference;
+    warehouses[numWarehouses++] = w;
+
+    if (activeWarehouse == NULL)
+        activeWarehouse = w;
+    return w;
+}
+
+// Returns the warehouse with the given ID, or NULL
+struct Warehouse* findWarehouse(int id) {
+    if (id < 0 || id >= numWarehouses)
+        return NULL;
+    return warehouses[id];
+}
+
+int warehouseCount() {
+    return numWarehouses;
+}
+
+// Makes w the calling thread's active warehouse and returns the previous one
+struct Warehouse* selectWarehouse(struct Warehouse *w) {
+    struct Warehouse *prev = activeWarehouse;
+    activeWarehouse = w;
+    return prev;
+}
+
+// ---------------------- FULFILLMENT ROUTING ----------------------
+
+// Picks the site for an order. A site's available stock is its stock on hand
+// minus the quantity already queued there for the product. Sites with enough
+// available stock to fill the order win, ordered by routing preference and
+// then by available stock. If none can fill it, the site with the most
+// available stock takes it so it waits for restocking there.
+// Returns NULL if no site carries the product.
+struct Warehouse* routeOrder(int productId, int quantity) {
+    struct Warehouse *best = NULL;
+    int bestAvailable = 0, bestFills = 0;
+
+    for (int i = 0; i < numWarehouses; i++) {
+        struct Product *p = searchBST(warehouses[i]->root, productId);
+        if (p == NULL)
+            continue;
+
+        struct Warehouse *prev = selectWarehouse(warehouses[i]);
+        int available = p->stock - pendingQuantity(productId);
+        selectWarehouse(prev);
+
+        int fills = available >= quantity;
+        int better;
+        if (best == NULL)
+            better = 1;
+        else if (fills != bestFills)
+            better = fills;
+        else if (fills && warehouses[i]->preference != best->preference)
+            better = warehouses[i]->preference < best->preference;
+        else
+            better = available > bestAvailable;
+
+        if (better) {
+            best = warehouses[i];
+            bestAvailable = available;
+            bestFills = fills;
+        }
+    }
+    return best;
+}
+
+// ---------------------- PARALLEL DISPATCH ----------------------
+
+struct DispatchJob {
+    struct Warehouse *warehouse;
+    int dispatched;
+};
+
+// Drains one warehouse's order queue in priority order
+static void* dispatchWorker(void *arg) {
+    struct DispatchJob *job = (struct DispatchJob*)arg;
+    selectWarehouse(job->warehouse);
+
+    struct Order *order;
+    while ((order = deleteMax()) != NULL) {
+        updateStockAfterDispatch(order->productId, order->quantity);
+        free(order);
+        job->dispatched++;
+    }
+    return NULL;
+}
+
+// Dispatches every pending order at every site, one worker thread per site.
+// Returns the total number of orders dispatched.
+int dispatchAllWarehouses() {
+    pthread_t threads[MAX_WAREHOUSES];
+    struct DispatchJob jobs[MAX_WAREHOUSES];
+    int started[MAX_WAREHOUSES];
+    int total = 0;
+
+    for (int i = 0; i < numWarehouses; i++) {
+        jobs[i].warehouse = warehouses[i];
+        jobs[i].dispatched = 0;
+        started[i] = warehouses[i]->front != NULL
+                  && pthread_create(&threads[i], NULL, dispatchWorker, &jobs[i]) == 0;
+        // Fall back to dispatching inline if a thread cannot be started
+        if (!started[i] && warehouses[i]->front != NULL) {
+            struct Warehouse *prev = selectWarehouse(warehouses[i]);
+            dispatchWorker(&jobs[i]);
+            selectWarehouse(prev);
+        }
+    }
+
+    for (int i = 0; i < numWarehouses; i++) {
+        if (started[i])
+            pthread_join(threads[i], NULL);
+        if (jobs[i].dispatched > 0)
+            printf("Warehouse %s: dispatched %d orders.\n", stringOf(warehouses[i]->name), jobs[i].dispatched);
+        total += jobs[i].dispatched;
+    }
+    return total;
+}
+
+// Lists every site with its size, queue length and revenue
+void displayWarehouses() {
+    printf("\n=== WAREHOUSES ===\n");
+    for (int i = 0; i < numWarehouses; i++) {
+        struct Warehouse *prev = selectWarehouse(warehouses[i]);
+        printf("%2d. %-15s | Preference: %2d | Products: %5d | Pending Orders: %4d | Revenue: $%10.2f%s\n",
+               warehouses[i]->id, stringOf(warehouses[i]->name), warehouses[i]->preference,
+               countProducts(warehouses[i]->root), countPendingOrders(), calculateTotalRevenue(),
+               prev == warehouses[i] ? " (active)" : "");
+        selectWarehouse(prev);
+    }
+}